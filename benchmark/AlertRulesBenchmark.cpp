@@ -0,0 +1,40 @@
+/**
+ * @file AlertRulesBenchmark.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "mobilesacn/libmobilesacn/handler/AlertRules.h"
+#include <benchmark/benchmark.h>
+
+using namespace mobilesacn::handler;
+
+/**
+ * Check a frame that trips nothing against @p state.range(0) rules over the whole universe, which
+ * is the usual case.
+ */
+static void BM_AlertRulesEvaluate(benchmark::State &state)
+{
+    std::vector<AlertRules::Rule> rules;
+    for (uint32_t id = 0; id < static_cast<uint32_t>(state.range(0)); ++id) {
+        rules.push_back({
+            .id = id,
+            .kind = id % 2 == 0 ? AlertRules::Kind::LevelAbove : AlertRules::Kind::Changed,
+            .start = 0,
+            .count = kSacnDmxAddressCount,
+            .level = 255,
+        });
+    }
+    AlertRules alertRules;
+    alertRules.setRules(rules);
+    AlertRules::Buffer levels{};
+    std::vector<AlertRules::Event> events;
+    for (auto _ : state) {
+        alertRules.evaluate(levels, 1, events);
+        benchmark::DoNotOptimize(events);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * kSacnDmxAddressCount);
+}
+BENCHMARK(BM_AlertRulesEvaluate)->Arg(1)->Arg(8)->Arg(64);
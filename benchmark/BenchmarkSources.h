@@ -0,0 +1,38 @@
+/**
+ * @file BenchmarkSources.h
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#ifndef MOBILESACN_BENCHMARK_BENCHMARKSOURCES_H
+#define MOBILESACN_BENCHMARK_BENCHMARKSOURCES_H
+
+#include "sacn/common.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Buffers for @p sourceCount sources fighting over the whole universe, at a few priorities.
+ */
+struct Sources
+{
+    using Buffer = std::array<uint8_t, kSacnDmxAddressCount>;
+
+    std::vector<Buffer> levels;
+    std::vector<Buffer> priorities;
+
+    explicit Sources(std::size_t sourceCount) : levels(sourceCount), priorities(sourceCount)
+    {
+        for (std::size_t ix = 0; ix < sourceCount; ++ix) {
+            for (std::size_t address = 0; address < kSacnDmxAddressCount; ++address) {
+                levels[ix][address] = static_cast<uint8_t>((address * 7 + ix * 13) & 0xFF);
+                priorities[ix][address] = static_cast<uint8_t>(100 + (address + ix) % 3);
+            }
+        }
+    }
+};
+
+#endif //MOBILESACN_BENCHMARK_BENCHMARKSOURCES_H
@@ -0,0 +1,67 @@
+/**
+ * @file ChangeJournalBenchmark.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "mobilesacn/libmobilesacn/handler/ChangeJournal.h"
+#include <benchmark/benchmark.h>
+
+using namespace mobilesacn::handler;
+
+/**
+ * A journal that has wrapped around, with changes spread over the universe.
+ */
+static void fillJournal(ChangeJournal &journal)
+{
+    ChangeJournal::Buffer levels{};
+    std::array<std::string, kSacnDmxAddressCount> owners;
+    owners.fill("a2b4c6d8-0000-4000-8000-000000000000");
+    auto time = ChangeJournal::Clock::now();
+    for (std::size_t frame = 0; frame < ChangeJournal::kCapacity / 8; ++frame) {
+        auto newLevels = levels;
+        // A fade over 16 addresses.
+        for (std::size_t ix = 0; ix < 16; ++ix) {
+            ++newLevels[(frame * 16 + ix) % kSacnDmxAddressCount];
+        }
+        time += std::chrono::milliseconds(23);
+        journal.record(time, levels, newLevels, owners);
+        levels = newLevels;
+    }
+}
+
+/**
+ * Record a frame where @p state.range(0) addresses changed.
+ */
+static void BM_ChangeJournalRecord(benchmark::State &state)
+{
+    ChangeJournal journal;
+    fillJournal(journal);
+    ChangeJournal::Buffer oldLevels{};
+    ChangeJournal::Buffer newLevels{};
+    for (std::size_t address = 0; address < static_cast<std::size_t>(state.range(0)); ++address) {
+        newLevels[address] = 255;
+    }
+    std::array<std::string, kSacnDmxAddressCount> owners;
+    for (auto _ : state) {
+        journal.record(ChangeJournal::Clock::now(), oldLevels, newLevels, owners);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ChangeJournalRecord)->Arg(1)->Arg(16)->Arg(512);
+
+/**
+ * When did an address last change, and who changed it?
+ */
+static void BM_ChangeJournalLastChange(benchmark::State &state)
+{
+    ChangeJournal journal;
+    fillJournal(journal);
+    for (auto _ : state) {
+        const auto changes = journal.query({.address = 212, .limit = 1});
+        benchmark::DoNotOptimize(changes);
+    }
+}
+BENCHMARK(BM_ChangeJournalLastChange);
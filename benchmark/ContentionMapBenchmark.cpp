@@ -0,0 +1,31 @@
+/**
+ * @file ContentionMapBenchmark.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "BenchmarkSources.h"
+#include "mobilesacn/libmobilesacn/handler/ContentionMap.h"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+using namespace mobilesacn::handler;
+
+static void BM_ContentionMap(benchmark::State &state)
+{
+    const Sources sources(state.range(0));
+    std::vector<ContentionMap::Input> inputs;
+    for (std::size_t ix = 0; ix < sources.levels.size(); ++ix) {
+        inputs.push_back({.levels = &sources.levels[ix], .priorities = &sources.priorities[ix]});
+    }
+
+    ContentionMap::Result result;
+    for (auto _ : state) {
+        ContentionMap::compute(inputs, result);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * kSacnDmxAddressCount);
+}
+BENCHMARK(BM_ContentionMap)->Arg(1)->Arg(4)->Arg(16)->Arg(64);
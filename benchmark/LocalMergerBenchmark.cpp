@@ -0,0 +1,81 @@
+/**
+ * @file LocalMergerBenchmark.cpp
+ *
+ * Compares LocalMerger with the sACN library's merger, which sacn::MergeReceiver merges with.
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "BenchmarkSources.h"
+#include "mobilesacn/libmobilesacn/handler/LocalMerger.h"
+#include <benchmark/benchmark.h>
+#include <sacn/cpp/common.h>
+#include <sacn/cpp/dmx_merger.h>
+#include <vector>
+
+using namespace mobilesacn::handler;
+
+/**
+ * Merge every source from scratch, as a what-if merge does.
+ */
+static void BM_LocalMerge(benchmark::State &state)
+{
+    const Sources sources(state.range(0));
+    std::vector<LocalMerger::Input> inputs;
+    for (std::size_t ix = 0; ix < sources.levels.size(); ++ix) {
+        inputs.push_back({.levels = &sources.levels[ix], .priorities = &sources.priorities[ix]});
+    }
+    // Ask what would happen if the first source raised its priority.
+    inputs.front().priorityOverride = 120;
+
+    LocalMerger::Result result;
+    for (auto _ : state) {
+        LocalMerger::merge(inputs, result);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * kSacnDmxAddressCount);
+}
+BENCHMARK(BM_LocalMerge)->Arg(1)->Arg(4)->Arg(16)->Arg(64);
+
+/**
+ * Give the sACN library's merger a new frame from every source, which is what it does to merge
+ * every source.
+ */
+static void BM_SacnDmxMerger(benchmark::State &state)
+{
+    static const auto sacnInit = sacn::Init();
+    if (!sacnInit.IsOk()) {
+        state.SkipWithError(sacnInit.ToString());
+        return;
+    }
+
+    Sources sources(state.range(0));
+    LocalMerger::Buffer levels{};
+    LocalMerger::Buffer priorities{};
+    std::array<sacn_dmx_merger_source_t, kSacnDmxAddressCount> owners{};
+    sacn::DmxMerger::Settings settings(levels.data());
+    settings.per_address_priorities = priorities.data();
+    settings.owners = owners.data();
+    sacn::DmxMerger merger;
+    merger.Startup(settings);
+    std::vector<sacn_dmx_merger_source_t> handles;
+    for (std::size_t ix = 0; ix < sources.levels.size(); ++ix) {
+        const auto handle = merger.AddSource();
+        handles.push_back(*handle);
+        merger.UpdatePap(*handle, sources.priorities[ix].data(), kSacnDmxAddressCount);
+    }
+
+    for (auto _ : state) {
+        for (std::size_t ix = 0; ix < handles.size(); ++ix) {
+            // Change a level, as a real frame would.
+            ++sources.levels[ix][0];
+            merger.UpdateLevels(handles[ix], sources.levels[ix].data(), kSacnDmxAddressCount);
+        }
+        benchmark::DoNotOptimize(levels);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * kSacnDmxAddressCount);
+    merger.Shutdown();
+}
+BENCHMARK(BM_SacnDmxMerger)->Arg(1)->Arg(4)->Arg(16)->Arg(64);
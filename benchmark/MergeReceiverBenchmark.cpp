@@ -0,0 +1,58 @@
+/**
+ * @file MergeReceiverBenchmark.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "mobilesacn/libmobilesacn/handler/MergeReceiver.h"
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+using namespace mobilesacn::handler;
+
+/**
+ * Get owner CIDs with @c state.range(0) sources, each owning an equal slice of the universe.
+ */
+static void BM_GetOwnerCids(benchmark::State &state)
+{
+    const auto sourceCount = static_cast<std::size_t>(state.range(0));
+    MergeReceiver::SourceMap sources;
+    std::vector<sacn_remote_source_t> activeSources;
+    for (std::size_t ix = 0; ix < sourceCount; ++ix) {
+        sacn::MergeReceiver::Source source;
+        source.handle = static_cast<sacn_remote_source_t>(ix + 1);
+        source.cid = etcpal::Uuid::V4();
+        source.name = fmt::format("Source {}", ix + 1);
+        source.universe_priority = 100;
+        sources.emplace(source.cid, source);
+        activeSources.push_back(source.handle);
+    }
+
+    std::array<uint8_t, kSacnDmxAddressCount> levels{};
+    std::array<uint8_t, kSacnDmxAddressCount> priorities{};
+    std::array<sacn_remote_source_t, kSacnDmxAddressCount> owners{};
+    for (std::size_t address = 0; address < kSacnDmxAddressCount; ++address) {
+        levels[address] = static_cast<uint8_t>(address);
+        priorities[address] = 100;
+        owners[address] = activeSources[address * sourceCount / kSacnDmxAddressCount];
+    }
+
+    SacnRecvMergedData mergedData{};
+    mergedData.universe_id = 1;
+    mergedData.slot_range.start_address = 1;
+    mergedData.slot_range.address_count = kSacnDmxAddressCount;
+    mergedData.levels = levels.data();
+    mergedData.priorities = priorities.data();
+    mergedData.owners = owners.data();
+    mergedData.active_sources = activeSources.data();
+    mergedData.num_active_sources = activeSources.size();
+
+    for (auto _ : state) {
+        auto ownerCids = MergeReceiver::getOwnerCids(sources, mergedData);
+        benchmark::DoNotOptimize(ownerCids);
+    }
+    state.SetItemsProcessed(state.iterations() * kSacnDmxAddressCount);
+}
+BENCHMARK(BM_GetOwnerCids)->Arg(1)->Arg(4)->Arg(16)->Arg(64);
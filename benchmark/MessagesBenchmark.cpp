@@ -0,0 +1,95 @@
+/**
+ * @file MessagesBenchmark.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "mobilesacn_messages/ChanCheck.h"
+#include "mobilesacn_messages/ReceiveLevelsReq.h"
+#include "mobilesacn_messages/TransmitLevels.h"
+#include <benchmark/benchmark.h>
+
+using namespace mobilesacn;
+
+/**
+ * Copy the finished contents of @p builder, as if it was received over the network.
+ */
+static std::vector<uint8_t> finishedBuffer(const flatbuffers::FlatBufferBuilder &builder)
+{
+    return {builder.GetBufferPointer(), builder.GetBufferPointer() + builder.GetSize()};
+}
+
+static void BM_ParseReceiveLevelsReq(benchmark::State &state)
+{
+    flatbuffers::FlatBufferBuilder builder;
+    builder.Finish(message::CreateReceiveLevelsReq(
+        builder,
+        message::ReceiveLevelsReqVal::universe,
+        builder.CreateStruct(message::Universe(1)).Union()));
+    const auto data = finishedBuffer(builder);
+    for (auto _ : state) {
+        const auto msg = message::GetReceiveLevelsReq(data.data());
+        if (msg->val_type() == message::ReceiveLevelsReqVal::universe) {
+            benchmark::DoNotOptimize(msg->val_as_universe()->universe());
+        }
+    }
+}
+BENCHMARK(BM_ParseReceiveLevelsReq);
+
+static void BM_ParseTransmitLevels(benchmark::State &state)
+{
+    std::array<uint8_t, 512> levels{};
+    levels.fill(255);
+    flatbuffers::FlatBufferBuilder builder;
+    builder.Finish(message::CreateTransmitLevels(
+        builder,
+        message::TransmitLevelsVal::levels,
+        builder.CreateStruct(message::LevelBuffer(levels)).Union()));
+    const auto data = finishedBuffer(builder);
+    std::array<uint8_t, 512> levelBuf{};
+    for (auto _ : state) {
+        const auto msg = message::GetTransmitLevels(data.data());
+        if (msg->val_type() == message::TransmitLevelsVal::levels) {
+            const auto levelsData = msg->val_as_levels()->levels();
+            std::memcpy(levelBuf.data(), levelsData->data(), levelBuf.size());
+            benchmark::DoNotOptimize(levelBuf.data());
+        }
+    }
+}
+BENCHMARK(BM_ParseTransmitLevels);
+
+static void BM_ParseChanCheck(benchmark::State &state)
+{
+    flatbuffers::FlatBufferBuilder builder;
+    builder.Finish(message::CreateChanCheck(
+        builder, message::ChanCheckVal::level, builder.CreateStruct(message::Level(255)).Union()));
+    const auto data = finishedBuffer(builder);
+    for (auto _ : state) {
+        const auto msg = message::GetChanCheck(data.data());
+        if (msg->val_type() == message::ChanCheckVal::level) {
+            benchmark::DoNotOptimize(msg->val_as_level()->level());
+        }
+    }
+}
+BENCHMARK(BM_ParseChanCheck);
+
+/**
+ * Cost of verifying the largest request before trusting it.
+ */
+static void BM_VerifyTransmitLevels(benchmark::State &state)
+{
+    std::array<uint8_t, 512> levels{};
+    flatbuffers::FlatBufferBuilder builder;
+    builder.Finish(message::CreateTransmitLevels(
+        builder,
+        message::TransmitLevelsVal::levels,
+        builder.CreateStruct(message::LevelBuffer(levels)).Union()));
+    const auto data = finishedBuffer(builder);
+    for (auto _ : state) {
+        flatbuffers::Verifier verifier(data.data(), data.size());
+        benchmark::DoNotOptimize(message::VerifyTransmitLevelsBuffer(verifier));
+    }
+}
+BENCHMARK(BM_VerifyTransmitLevels);
@@ -0,0 +1,116 @@
+/**
+ * @file ReceiveLevelsBenchmark.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "mobilesacn/libmobilesacn/handler/ReceiveLevels.h"
+#include <benchmark/benchmark.h>
+
+using namespace mobilesacn::handler;
+
+/**
+ * Last seen buffers with @p sourceCount sources each owning an equal slice of the universe.
+ */
+static ReceiveLevels::LastSeen makeLastSeen(std::size_t sourceCount)
+{
+    std::vector<std::string> cids;
+    for (std::size_t ix = 0; ix < sourceCount; ++ix) {
+        cids.push_back(etcpal::Uuid::V4().ToString());
+    }
+
+    ReceiveLevels::LastSeen lastSeen;
+    for (std::size_t address = 0; address < kSacnDmxAddressCount; ++address) {
+        lastSeen.levels[address] = static_cast<uint8_t>(address);
+        lastSeen.priorities[address] = 100;
+        lastSeen.owners[address] = cids[address * sourceCount / kSacnDmxAddressCount];
+    }
+    return lastSeen;
+}
+
+/**
+ * Encode a full frame, as sent in the normal "display current levels" mode.
+ */
+static void BM_EncodeLevelsChanged(benchmark::State &state)
+{
+    const auto lastSeen = makeLastSeen(state.range(0));
+    flatbuffers::FlatBufferBuilder builder;
+    for (auto _ : state) {
+        builder.Clear();
+        ReceiveLevels::buildLevelsChanged(builder, lastSeen, 0);
+        benchmark::DoNotOptimize(builder.GetBufferPointer());
+    }
+    state.counters["bytes_per_frame"] = builder.GetSize();
+    state.SetBytesProcessed(state.iterations() * builder.GetSize());
+}
+BENCHMARK(BM_EncodeLevelsChanged)->Arg(1)->Arg(4)->Arg(64);
+
+/**
+ * Encode a frame for a client subscribed only to levels.
+ */
+static void BM_EncodeLevelsOnly(benchmark::State &state)
+{
+    const auto lastSeen = makeLastSeen(state.range(0));
+    flatbuffers::FlatBufferBuilder builder;
+    for (auto _ : state) {
+        builder.Clear();
+        ReceiveLevels::buildLevelsChanged(
+            builder, lastSeen, 0, flatbuffers::nullopt, mobilesacn::message::LevelsField::Levels);
+        benchmark::DoNotOptimize(builder.GetBufferPointer());
+    }
+    state.counters["bytes_per_frame"] = builder.GetSize();
+    state.SetBytesProcessed(state.iterations() * builder.GetSize());
+}
+BENCHMARK(BM_EncodeLevelsOnly)->Arg(1)->Arg(64);
+
+/**
+ * Encode a frame for a client viewing the first @c state.range(0) addresses.
+ */
+static void BM_EncodeAddressWindow(benchmark::State &state)
+{
+    const auto lastSeen = makeLastSeen(4);
+    const ReceiveLevels::AddressWindow window{
+        .start = 0, .count = static_cast<std::size_t>(state.range(0))};
+    flatbuffers::FlatBufferBuilder builder;
+    for (auto _ : state) {
+        builder.Clear();
+        ReceiveLevels::buildLevelsChanged(
+            builder,
+            lastSeen,
+            0,
+            flatbuffers::nullopt,
+            mobilesacn::message::LevelsField::ANY,
+            {&window, 1});
+        benchmark::DoNotOptimize(builder.GetBufferPointer());
+    }
+    state.counters["bytes_per_frame"] = builder.GetSize();
+    state.SetBytesProcessed(state.iterations() * builder.GetSize());
+}
+BENCHMARK(BM_EncodeAddressWindow)->Arg(48)->Arg(512);
+
+/**
+ * Encode a flicker finder frame where @c state.range(0) addresses changed.
+ */
+static void BM_EncodeFlicker(benchmark::State &state)
+{
+    const auto changedCount = static_cast<std::size_t>(state.range(0));
+    std::array<uint8_t, kSacnDmxAddressCount> oldLevels{};
+    std::array<uint8_t, kSacnDmxAddressCount> newLevels{};
+    std::array<uint8_t, kSacnDmxAddressCount> referenceLevels{};
+    for (std::size_t ix = 0; ix < changedCount; ++ix) {
+        // Spread the changes out across the universe.
+        newLevels[ix * kSacnDmxAddressCount / changedCount] = 255;
+    }
+    flatbuffers::FlatBufferBuilder builder;
+    for (auto _ : state) {
+        builder.Clear();
+        const auto built
+            = ReceiveLevels::buildFlicker(builder, oldLevels, newLevels, referenceLevels, 0);
+        benchmark::DoNotOptimize(built);
+        benchmark::DoNotOptimize(builder.GetBufferPointer());
+    }
+    state.counters["bytes_per_frame"] = builder.GetSize();
+}
+BENCHMARK(BM_EncodeFlicker)->Arg(0)->Arg(1)->Arg(16)->Arg(512);
@@ -0,0 +1,32 @@
+/**
+ * @file SnapshotStoreBenchmark.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "mobilesacn/libmobilesacn/handler/SnapshotStore.h"
+#include <benchmark/benchmark.h>
+
+using namespace mobilesacn::handler;
+
+/**
+ * Compare two universes where every @p state.range(0)th address differs.
+ */
+static void BM_SnapshotDiff(benchmark::State &state)
+{
+    UniverseSnapshot::Buffer levels{};
+    UniverseSnapshot::Buffer priorities{};
+    priorities.fill(100);
+    auto otherLevels = levels;
+    const auto stride = static_cast<std::size_t>(state.range(0));
+    for (std::size_t address = 0; address < kSacnDmxAddressCount; address += stride) {
+        otherLevels[address] = 255;
+    }
+    for (auto _ : state) {
+        const auto runs = SnapshotStore::diff(levels, priorities, otherLevels, priorities);
+        benchmark::DoNotOptimize(runs);
+    }
+}
+BENCHMARK(BM_SnapshotDiff)->Arg(1)->Arg(2)->Arg(64)->Arg(kSacnDmxAddressCount + 1);
@@ -0,0 +1,51 @@
+/**
+ * @file SourceTapBenchmark.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "mobilesacn/libmobilesacn/handler/SourceTap.h"
+#include <benchmark/benchmark.h>
+#include <cstring>
+
+using namespace mobilesacn::handler;
+
+/**
+ * An E1.31 data packet for universe 1 carrying a full universe of levels.
+ */
+static std::vector<uint8_t> makeDataPacket()
+{
+    std::vector<uint8_t> packet(638);
+    const auto put16 = [&packet](std::size_t offset, uint16_t value) {
+        packet[offset] = static_cast<uint8_t>(value >> 8);
+        packet[offset + 1] = static_cast<uint8_t>(value & 0xFF);
+    };
+    put16(0, 0x0010);
+    std::memcpy(packet.data() + 4, "ASC-E1.17\0\0\0", 12);
+    packet[21] = 0x04;
+    const auto cid = etcpal::Uuid::V4();
+    std::memcpy(packet.data() + 22, cid.data(), 16);
+    packet[43] = 0x02;
+    packet[108] = 100;
+    put16(113, 1);
+    packet[117] = 0x02;
+    packet[118] = 0xA1;
+    put16(121, 1);
+    put16(123, kSacnDmxAddressCount + 1);
+    for (std::size_t address = 0; address < kSacnDmxAddressCount; ++address) {
+        packet[126 + address] = static_cast<uint8_t>(address);
+    }
+    return packet;
+}
+
+static void BM_ParseDataPacket(benchmark::State &state)
+{
+    const auto packet = makeDataPacket();
+    for (auto _ : state) {
+        const auto parsed = SourceTap::parseDataPacket(packet);
+        benchmark::DoNotOptimize(parsed);
+    }
+}
+BENCHMARK(BM_ParseDataPacket);
@@ -0,0 +1,31 @@
+/**
+ * @file TransmitLevelsBenchmark.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "mobilesacn/libmobilesacn/handler/TransmitLevels.h"
+#include <benchmark/benchmark.h>
+
+using namespace mobilesacn::handler;
+
+/**
+ * Compute PAP for a universe where every other address is in use.
+ */
+static void BM_UpdatePap(benchmark::State &state)
+{
+    std::array<uint8_t, kSacnDmxAddressCount> levels{};
+    std::array<uint8_t, kSacnDmxAddressCount> pap{};
+    for (std::size_t address = 0; address < levels.size(); address += 2) {
+        levels[address] = 255;
+    }
+    for (auto _ : state) {
+        TransmitLevels::updatePap(levels, pap, 100);
+        benchmark::DoNotOptimize(pap.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kSacnDmxAddressCount);
+}
+BENCHMARK(BM_UpdatePap);
@@ -25,21 +25,22 @@ const serverOrigin = (() => {
     return document.location.origin;
 })();
 
+// Websockets are served on the same port as everything else.
+const wsRoot = serverOrigin.replace(/^http/, "ws");
+
 interface ClientSettings {
-    wsRoot: string;
     preferredColorScheme?: string;
     levelDisplayMode?: string;
 }
 
 async function loadClientSettings() {
     const response = await fetch(`${serverOrigin}/clientsettings`);
-    const json = await response.json() as Partial<ClientSettings>;
-
-    if (json.wsRoot === undefined) {
-        throw new Error("wsRoot not in server response.");
+    if (!response.ok) {
+        throw new Error(`${response.status} ${response.statusText}`);
     }
+    const json = await response.json() as Partial<ClientSettings>;
 
-    const appContext: Partial<IAppContext> = {wsRoot: json.wsRoot};
+    const appContext: Partial<IAppContext> = {};
 
     // Preferred color scheme
     switch (json.preferredColorScheme) {
@@ -72,6 +73,7 @@ async function loadClientSettings() {
 
 const App: Component<{ children: Element }> = (props) => {
     const [appContext, setAppContext] = useAppContext();
+    setAppContext("wsRoot", wsRoot);
     const [translator] = createResource(createTranslator);
     createEffect(() => {
         if (translator.state == "ready") {
@@ -91,7 +93,7 @@ const App: Component<{ children: Element }> = (props) => {
             return;
         }
 
-        const saveSettings: Omit<ClientSettings, "wsRoot"> = {};
+        const saveSettings: ClientSettings = {};
         saveSettings.preferredColorScheme = appContext.preferredColorScheme ?? "";
         saveSettings.levelDisplayMode = appContext.levelDisplayMode;
 
@@ -117,10 +119,6 @@ const App: Component<{ children: Element }> = (props) => {
         // Can't use fallback here because the loading element relies on the translator.
         <Show when={translator.state == "ready"}>
             <Switch>
-                <Match when={clientSettings.loading}>
-                    <Loading/>
-                </Match>
-
                 <Match when={clientSettings.error}>
                     <Alert variant="danger">
                         <p>{t("clientSettings.error.title")}</p>
@@ -133,7 +131,8 @@ const App: Component<{ children: Element }> = (props) => {
                     </Alert>
                 </Match>
 
-                <Match when={clientSettings.state == "ready"}>
+                {/* Don't wait for settings, as pages can connect without them. */}
+                <Match when={!clientSettings.error}>
                     <Navbar class="msacn-navbar-main" expand="lg" fixed="top" collapseOnSelect>
                         <Container fluid>
                             <Navbar.Brand as={A} href={LINKS.front_home}>
@@ -188,6 +187,7 @@ interface SettingsDialogProps {
 
 const SettingsDialog: Component<SettingsDialogProps> = (props) => {
     const [appContext, setAppContext] = useAppContext();
+    setAppContext("wsRoot", wsRoot);
 
     let colorSchemeRef!: HTMLSelectElement;
     let levelDisplayModeRef!: HTMLSelectElement;
@@ -16,7 +16,7 @@ export interface IAppContext {
 }
 
 const defaultAppContext: IAppContext = {
-    wsRoot: `${document.location.origin}/ws`,
+    wsRoot: document.location.origin.replace(/^http/, "ws"),
     preferredColorScheme: undefined,
     activeColorScheme: ColorScheme.Light,
     levelDisplayMode: LevelDisplayMode.PERCENT,
@@ -1,6 +1,7 @@
 import {ColorScheme, useAppContext} from "@/common/AppContext";
 import bigIntAbs from "@/common/bigIntAbs";
 import colorForCID, {type CidColor} from "@/common/cidColor";
+import clamp from "@/common/clamp";
 import Connecting from "@/common/components/Connecting";
 import {LevelBar} from "@/common/components/LevelBar";
 import {LevelDisplay, PriorityDisplay} from "@/common/components/LevelDisplay";
@@ -8,17 +9,42 @@ import {DMX_MAX, SACN_UNIV_MAX, SACN_UNIV_MIN} from "@/common/constants";
 import {generate} from "@/common/generate";
 import getBootstrapColor from "@/common/getBootstrapColor";
 import unique from "@/common/unique";
+import {AddressRange} from "@/messages/address-range";
+import {AlertEvent} from "@/messages/alert-event";
+import {AlertKind} from "@/messages/alert-kind";
+import {AlertRule} from "@/messages/alert-rule";
+import {AlertRules} from "@/messages/alert-rules";
+import {Alerts} from "@/messages/alerts";
+import {AddressWindows} from "@/messages/address-windows";
+import {Batch} from "@/messages/batch";
+import {Contention} from "@/messages/contention";
+import {ContentionFinder} from "@/messages/contention-finder";
+import {FieldMask} from "@/messages/field-mask";
 import {Flicker} from "@/messages/flicker";
 import {FlickerFinder} from "@/messages/flicker-finder";
+import {Journal} from "@/messages/journal";
+import {JournalQuery} from "@/messages/journal-query";
 import {LevelBuffer} from "@/messages/level-buffer";
 import {LevelsChanged} from "@/messages/levels-changed";
+import {LevelsField} from "@/messages/levels-field";
+import {PriorityOverride} from "@/messages/priority-override";
 import {ReceiveLevelsReq} from "@/messages/receive-levels-req";
 import {ReceiveLevelsReqVal} from "@/messages/receive-levels-req-val";
 import {ReceiveLevelsResp} from "@/messages/receive-levels-resp";
 import {ReceiveLevelsRespVal} from "@/messages/receive-levels-resp-val";
+import {SequenceStats} from "@/messages/sequence-stats";
+import {SnapshotAction} from "@/messages/snapshot-action";
+import {SnapshotDiff} from "@/messages/snapshot-diff";
+import {SnapshotDiffStatus} from "@/messages/snapshot-diff-status";
+import {SnapshotList} from "@/messages/snapshot-list";
+import {SnapshotReq} from "@/messages/snapshot-req";
 import {SourceExpired} from "@/messages/source-expired";
+import {SourceLevels} from "@/messages/source-levels";
+import {SourceSelection} from "@/messages/source-selection";
 import {SourceUpdated} from "@/messages/source-updated";
 import {Universe} from "@/messages/universe";
+import {WhatIf} from "@/messages/what-if";
+import {WhatIfLevels} from "@/messages/what-if-levels";
 import ReceiveLevelsTitle from "@/pages/receive/levels/ReceiveLevelsTitle";
 import {createEventListener} from "@solid-primitives/event-listener";
 import {IndexRange, Repeat} from "@solid-primitives/range";
@@ -42,16 +68,110 @@ import {
     Tooltip,
 } from "solid-bootstrap";
 import {BsList, BsTable} from "solid-icons/bs";
-import {type Component, createEffect, createMemo, createSignal, createUniqueId, For, Index, Show} from "solid-js";
+import {
+    type Component,
+    createEffect,
+    createMemo,
+    createSignal,
+    createUniqueId,
+    For,
+    Index,
+    Match,
+    onCleanup,
+    Show,
+    Switch,
+} from "solid-js";
 import "./ReceiveLevelsPage.scss";
 import {Portal} from "solid-js/web";
 
 
+/** First and last address index in view. */
+type AddressWindow = [number, number];
+
 enum ViewMode {
     GRID = "grid",
     BARS = "faders",
 }
 
+/** A source's own levels, before merging. */
+interface UnmergedLevels {
+    levels: number[];
+    priorities: number[];
+}
+
+/** The result of a what-if merge. */
+interface WhatIfResult extends UnmergedLevels {
+    owners: string[];
+}
+
+/** Packet counts for a source. */
+interface PacketStats {
+    received: bigint;
+    lost: bigint;
+    duplicated: bigint;
+    outOfOrder: bigint;
+}
+
+enum ContentionState {
+    NONE,
+    /** Sources tie on priority and send the same level. */
+    TIE,
+    /** Sources tie on priority, so HTP picks between their levels. */
+    FIGHT,
+}
+
+interface ClientAlertRule {
+    id: number;
+    kind: AlertKind;
+    /** Address - 1. */
+    start: number;
+    count: number;
+    level: number;
+    sources: number;
+}
+
+interface ClientAlertEvent {
+    rule: ClientAlertRule;
+    active: boolean;
+    /** Address - 1. */
+    address: number | null;
+    level: number;
+}
+
+interface SnapshotEntry {
+    name: string;
+    universe: number;
+    /** Server time. */
+    timestamp: bigint;
+}
+
+interface SnapshotDiffRun {
+    /** Address - 1. */
+    start: number;
+    levels: number[];
+    otherLevels: number[];
+}
+
+interface SnapshotDiffResult {
+    name: string;
+    universe: number;
+    /** Null if compared to the current levels. */
+    other: string | null;
+    otherUniverse: number;
+    status: SnapshotDiffStatus;
+    runs: SnapshotDiffRun[];
+}
+
+interface JournalEntry {
+    /** Server time. */
+    timestamp: bigint;
+    /** Address - 1. */
+    address: number;
+    oldLevel: number;
+    newLevel: number;
+    owner: string;
+}
+
 interface Source {
     cid: string;
     color: CidColor;
@@ -90,10 +210,26 @@ const SAME_COLOR: CidColor = {
     dark: new Color(getBootstrapColor("gray-700")),
 };
 
+const TIE_COLOR: CidColor = {
+    light: new Color(getBootstrapColor("yellow")),
+    dark: new Color(getBootstrapColor("orange")),
+};
+const FIGHT_COLOR: CidColor = {
+    light: new Color(getBootstrapColor("red")),
+    dark: new Color(getBootstrapColor("red")),
+};
+
+/** Changes to ask for at once. */
+const JOURNAL_LIMIT = 50;
+/** Alert events to keep showing. */
+const ALERT_EVENT_LIMIT = 20;
+
 const emptyLevelBuffer = () => Array.from(generate(DMX_MAX, 0));
 const emptyOwnerBuffer = () => Array.from(generate(DMX_MAX, ""));
 const emptyFlickerBuffer = () => Array.from(generate(DMX_MAX, null));
+const emptyContentionBuffer = () => Array.from(generate(DMX_MAX, ContentionState.NONE));
 const emptySourceMap = () => new Map<string, Source>();
+const emptyUnmergedMap = () => new Map<string, UnmergedLevels>();
 
 function* getSourceListUniverses(sources: Iterable<Source>): Generator<number> {
     for (const source of sources) {
@@ -129,10 +265,45 @@ const ReceiveLevelsPage: Component = () => {
         universes.sort((lhs, rhs) => lhs - rhs);
         return universes;
     });
+    const [packetStats, setPacketStats] = createSignal(new Map<string, PacketStats>());
+    const [journal, setJournal] = createSignal<JournalEntry[] | null>(null);
+    const [snapshots, setSnapshots] = createSignal<SnapshotEntry[]>([]);
+    const [snapshotDiff, setSnapshotDiff] = createSignal<SnapshotDiffResult | null>(null);
+    const [alertRules, setAlertRules] = createSignal<ClientAlertRule[]>([]);
+    const [alertEvents, setAlertEvents] = createSignal<ClientAlertEvent[]>([]);
+    let nextAlertRuleId = 1;
+    const addAlertRule = (rule: Omit<ClientAlertRule, "id">) => {
+        setAlertRules([...alertRules(), {...rule, id: nextAlertRuleId++}]);
+    };
+    const removeAlertRule = (id: number) => {
+        setAlertRules(alertRules().filter(rule => rule.id != id));
+    };
+    const [selectedSources, setSelectedSources] = createSignal<string[]>([]);
+    const [unmerged, setUnmerged] = createSignal(emptyUnmergedMap());
+    const toggleSelectedSource = (cid: string) => {
+        const selected = selectedSources();
+        setSelectedSources(selected.includes(cid) ? selected.filter(other => other != cid) : [...selected, cid]);
+    };
+    const [whatIfPriorities, setWhatIfPriorities] = createSignal(new Map<string, number>());
+    const [whatIfResult, setWhatIfResult] = createSignal<WhatIfResult | null>(null);
+    const setWhatIfPriority = (cid: string, priority: number | null) => {
+        const newPriorities = new Map(whatIfPriorities().entries());
+        if (priority === null) {
+            newPriorities.delete(cid);
+        } else {
+            newPriorities.set(cid, priority);
+        }
+        setWhatIfPriorities(newPriorities);
+    };
     const [viewMode, setViewMode] = createSignal(ViewMode.GRID);
     const [showPriorities, setShowPriorities] = createSignal(true);
+    const [addressWindow, setAddressWindow] = createSignal<AddressWindow | null>(null, {
+        equals: (prev, next) => prev?.[0] === next?.[0] && prev?.[1] === next?.[1],
+    });
     const [flickerFinder, setFlickerFinder] = createSignal(false);
     const [flickers, setFlickers] = createSignal<(number | null)[]>(emptyFlickerBuffer());
+    const [contentionFinder, setContentionFinder] = createSignal(false);
+    const [contention, setContention] = createSignal(emptyContentionBuffer());
     const [showFlickerDialog, setShowFlickerDialog] = createSignal(false);
     const openFlickerDialog = () => setShowFlickerDialog(true);
     const closeFlickerDialog = () => setShowFlickerDialog(false);
@@ -152,6 +323,15 @@ const ReceiveLevelsPage: Component = () => {
                     return SAME_COLOR;
                 }
             });
+        } else if (contentionFinder()) {
+            return contention().map(state => {
+                if (state == ContentionState.FIGHT) {
+                    return FIGHT_COLOR;
+                } else if (state == ContentionState.TIE) {
+                    return TIE_COLOR;
+                }
+                return DEFAULT_SOURCE.color;
+            });
         } else {
             return owners().map(cid => {
                 const source = sourceMap().get(cid) ?? DEFAULT_SOURCE;
@@ -192,18 +372,201 @@ const ReceiveLevelsPage: Component = () => {
     };
 
     const onLevelsChanged = (msg: LevelsChanged) => {
-        const msgLevels = msg.levels(new LevelBuffer()) as LevelBuffer;
-        const newLevels = Array.from({length: LevelBuffer.sizeOf()}, (v, i) => msgLevels.levels(i)) as number[];
-        setLevels(newLevels);
+        if (msg.slicesLength() > 0) {
+            onLevelSlices(msg);
+            return;
+        }
 
-        const msgPriorities = msg.priorities(new LevelBuffer()) as LevelBuffer;
-        const newPriorities = Array.from({length: LevelBuffer.sizeOf()}, (v, i) => msgPriorities.levels(i)) as number[];
-        setPriorities(newPriorities);
+        // Fields we are not subscribed to are left out.
+        const msgLevels = msg.levels(new LevelBuffer());
+        if (msgLevels !== null) {
+            const newLevels = Array.from({length: LevelBuffer.sizeOf()}, (v, i) => msgLevels.levels(i)) as number[];
+            setLevels(newLevels);
+        }
+
+        const msgPriorities = msg.priorities(new LevelBuffer());
+        if (msgPriorities !== null) {
+            const newPriorities = Array.from({length: LevelBuffer.sizeOf()}, (v, i) => msgPriorities.levels(i)) as number[];
+            setPriorities(newPriorities);
+        }
+
+        if (msg.ownersLength() > 0) {
+            const newOwners = Array.from({length: msg.ownersLength()}, (v, i) => msg.owners(i));
+            setOwners(newOwners);
+        }
+    };
+
+    const onContention = (msg: Contention) => {
+        const counts = msg.countsArray() as Uint8Array;
+        const htp = msg.htpArray() as Uint8Array;
+        setContention(Array.from(counts, (count, address) => {
+            if ((htp[Math.floor(address / 8)] >> (address % 8)) & 1) {
+                return ContentionState.FIGHT;
+            } else if (count > 1) {
+                return ContentionState.TIE;
+            }
+            return ContentionState.NONE;
+        }));
+    };
+
+    const onAlerts = (msg: Alerts) => {
+        const newEvents: ClientAlertEvent[] = [];
+        for (let ix = 0; ix < msg.eventsLength(); ++ix) {
+            const event = msg.events(ix) as AlertEvent;
+            const rule = alertRules().find(rule => rule.id == event.id());
+            if (rule === undefined) {
+                // Removed since.
+                continue;
+            }
+            newEvents.push({
+                rule: rule,
+                active: event.active(),
+                address: event.address(),
+                level: event.level(),
+            });
+        }
+        newEvents.reverse();
+        setAlertEvents([...newEvents, ...alertEvents()].slice(0, ALERT_EVENT_LIMIT));
+    };
 
-        const newOwners = Array.from({length: msg.ownersLength()}, (v, i) => msg.owners(i));
+    const onSnapshotList = (msg: SnapshotList) => {
+        const newSnapshots: SnapshotEntry[] = [];
+        for (let ix = 0; ix < msg.snapshotsLength(); ++ix) {
+            const snapshot = msg.snapshots(ix)!;
+            newSnapshots.push({
+                name: snapshot.name() as string,
+                universe: snapshot.universe(),
+                timestamp: snapshot.timestamp(),
+            });
+        }
+        setSnapshots(newSnapshots);
+    };
+
+    const onSnapshotDiff = (msg: SnapshotDiff) => {
+        const runs: SnapshotDiffRun[] = [];
+        for (let ix = 0; ix < msg.runsLength(); ++ix) {
+            const run = msg.runs(ix)!;
+            runs.push({
+                start: run.start(),
+                levels: Array.from(run.levelsArray() ?? []),
+                otherLevels: Array.from(run.otherLevelsArray() ?? []),
+            });
+        }
+        setSnapshotDiff({
+            name: msg.name() as string,
+            universe: msg.universe(),
+            other: msg.other(),
+            otherUniverse: msg.otherUniverse(),
+            status: msg.status(),
+            runs: runs,
+        });
+    };
+
+    const onJournal = (msg: Journal) => {
+        const entries: JournalEntry[] = [];
+        for (let ix = 0; ix < msg.changesLength(); ++ix) {
+            const change = msg.changes(ix)!;
+            entries.push({
+                timestamp: change.timestamp(),
+                address: change.address(),
+                oldLevel: change.oldLevel(),
+                newLevel: change.newLevel(),
+                owner: msg.owners(change.owner()),
+            });
+        }
+        setJournal(entries);
+    };
+
+    const onSequenceStats = (msg: SequenceStats) => {
+        const newPacketStats = new Map<string, PacketStats>();
+        for (let ix = 0; ix < msg.sourcesLength(); ++ix) {
+            const source = msg.sources(ix)!;
+            newPacketStats.set(source.cid() as string, {
+                received: source.received(),
+                lost: source.lost(),
+                duplicated: source.duplicated(),
+                outOfOrder: source.outOfOrder(),
+            });
+        }
+        setPacketStats(newPacketStats);
+    };
+
+    const onSourceLevels = (msg: SourceLevels) => {
+        const cid = msg.cid() as string;
+        const msgLevelsChanged = msg.levels() as LevelsChanged;
+        const old = unmerged().get(cid);
+        const newLevels = old?.levels.slice() ?? emptyLevelBuffer();
+        const newPriorities = old?.priorities.slice() ?? emptyLevelBuffer();
+        const msgLevels = msgLevelsChanged.levels(new LevelBuffer());
+        if (msgLevels !== null) {
+            for (let ix = 0; ix < LevelBuffer.sizeOf(); ++ix) {
+                newLevels[ix] = msgLevels.levels(ix) as number;
+            }
+        }
+        const msgPriorities = msgLevelsChanged.priorities(new LevelBuffer());
+        if (msgPriorities !== null) {
+            for (let ix = 0; ix < LevelBuffer.sizeOf(); ++ix) {
+                newPriorities[ix] = msgPriorities.levels(ix) as number;
+            }
+        }
+        applySlices(msgLevelsChanged, newLevels, newPriorities, null);
+        const newUnmerged = new Map(unmerged().entries());
+        newUnmerged.set(cid, {levels: newLevels, priorities: newPriorities});
+        setUnmerged(newUnmerged);
+    };
+
+    const onWhatIfLevels = (msg: WhatIfLevels) => {
+        const msgLevelsChanged = msg.levels() as LevelsChanged;
+        const old = whatIfResult();
+        const newLevels = old?.levels.slice() ?? emptyLevelBuffer();
+        const newPriorities = old?.priorities.slice() ?? emptyLevelBuffer();
+        const newOwners = old?.owners.slice() ?? emptyOwnerBuffer();
+        const msgLevels = msgLevelsChanged.levels(new LevelBuffer());
+        if (msgLevels !== null) {
+            for (let ix = 0; ix < LevelBuffer.sizeOf(); ++ix) {
+                newLevels[ix] = msgLevels.levels(ix) as number;
+            }
+        }
+        const msgPriorities = msgLevelsChanged.priorities(new LevelBuffer());
+        if (msgPriorities !== null) {
+            for (let ix = 0; ix < LevelBuffer.sizeOf(); ++ix) {
+                newPriorities[ix] = msgPriorities.levels(ix) as number;
+            }
+        }
+        for (let ix = 0; ix < msgLevelsChanged.ownersLength(); ++ix) {
+            newOwners[ix] = msgLevelsChanged.owners(ix);
+        }
+        applySlices(msgLevelsChanged, newLevels, newPriorities, newOwners);
+        setWhatIfResult({levels: newLevels, priorities: newPriorities, owners: newOwners});
+    };
+
+    const onLevelSlices = (msg: LevelsChanged) => {
+        // Only the addresses in view were sent, so keep everything else as is.
+        const newLevels = levels().slice();
+        const newPriorities = priorities().slice();
+        const newOwners = owners().slice();
+        applySlices(msg, newLevels, newPriorities, newOwners);
+        setLevels(newLevels);
+        setPriorities(newPriorities);
         setOwners(newOwners);
     };
 
+    const applySlices = (msg: LevelsChanged, newLevels: number[], newPriorities: number[], newOwners: string[] | null) => {
+        for (let ix = 0; ix < msg.slicesLength(); ++ix) {
+            const slice = msg.slices(ix)!;
+            const start = slice.start();
+            for (let jx = 0; jx < slice.levelsLength(); ++jx) {
+                newLevels[start + jx] = slice.levels(jx)!;
+            }
+            for (let jx = 0; jx < slice.prioritiesLength(); ++jx) {
+                newPriorities[start + jx] = slice.priorities(jx)!;
+            }
+            for (let jx = 0; newOwners !== null && jx < slice.ownersLength(); ++jx) {
+                newOwners[start + jx] = slice.owners(jx);
+            }
+        }
+    };
+
     const onFlicker = (msg: Flicker) => {
         const newFlickers = flickers().slice();
         const newLevels = levels().slice();
@@ -230,12 +593,16 @@ const ReceiveLevelsPage: Component = () => {
             ws.binaryType = "arraybuffer";
         }
     });
-    createEventListener(ws, "message", (e) => {
-        const data = new Uint8Array(e.data as ArrayBuffer);
-        const buf = new ByteBuffer(data);
-        const msg = ReceiveLevelsResp.getRootAsReceiveLevelsResp(buf);
-
-        if (msg.valType() == ReceiveLevelsRespVal.sourceUpdated) {
+    const onResp = (msg: ReceiveLevelsResp) => {
+        if (msg.valType() == ReceiveLevelsRespVal.batch) {
+            const msgBatch = msg.val(new Batch()) as Batch;
+            for (let ix = 0; ix < msgBatch.messagesLength(); ++ix) {
+                const payload = msgBatch.messages(ix)?.payloadArray();
+                if (payload) {
+                    onResp(ReceiveLevelsResp.getRootAsReceiveLevelsResp(new ByteBuffer(payload)));
+                }
+            }
+        } else if (msg.valType() == ReceiveLevelsRespVal.sourceUpdated) {
             const msgSourceUpdated = msg.val(new SourceUpdated()) as SourceUpdated;
             onSourceUpdated(msgSourceUpdated);
         } else if (msg.valType() == ReceiveLevelsRespVal.sourceExpired) {
@@ -250,12 +617,41 @@ const ReceiveLevelsPage: Component = () => {
             }
             const msgLevelsChanged = msg.val(new LevelsChanged()) as LevelsChanged;
             onLevelsChanged(msgLevelsChanged);
+        } else if (msg.valType() == ReceiveLevelsRespVal.sourceLevels) {
+            const msgSourceLevels = msg.val(new SourceLevels()) as SourceLevels;
+            onSourceLevels(msgSourceLevels);
+        } else if (msg.valType() == ReceiveLevelsRespVal.contention) {
+            const msgContention = msg.val(new Contention()) as Contention;
+            onContention(msgContention);
+        } else if (msg.valType() == ReceiveLevelsRespVal.alerts) {
+            const msgAlerts = msg.val(new Alerts()) as Alerts;
+            onAlerts(msgAlerts);
+        } else if (msg.valType() == ReceiveLevelsRespVal.snapshotList) {
+            const msgSnapshotList = msg.val(new SnapshotList()) as SnapshotList;
+            onSnapshotList(msgSnapshotList);
+        } else if (msg.valType() == ReceiveLevelsRespVal.snapshotDiff) {
+            const msgSnapshotDiff = msg.val(new SnapshotDiff()) as SnapshotDiff;
+            onSnapshotDiff(msgSnapshotDiff);
+        } else if (msg.valType() == ReceiveLevelsRespVal.journal) {
+            const msgJournal = msg.val(new Journal()) as Journal;
+            onJournal(msgJournal);
+        } else if (msg.valType() == ReceiveLevelsRespVal.sequenceStats) {
+            const msgSequenceStats = msg.val(new SequenceStats()) as SequenceStats;
+            onSequenceStats(msgSequenceStats);
+        } else if (msg.valType() == ReceiveLevelsRespVal.whatIfLevels) {
+            const msgWhatIfLevels = msg.val(new WhatIfLevels()) as WhatIfLevels;
+            onWhatIfLevels(msgWhatIfLevels);
         } else if (msg.valType() === ReceiveLevelsRespVal.flicker) {
             const msgFlicker = msg.val(new Flicker()) as Flicker;
             onFlicker(msgFlicker);
         } else if (msg.valType() == ReceiveLevelsRespVal.systemTime) {
             onSystemTime(msg.timestamp());
         }
+    };
+    createEventListener(ws, "message", (e) => {
+        const data = new Uint8Array(e.data as ArrayBuffer);
+        const buf = new ByteBuffer(data);
+        onResp(ReceiveLevelsResp.getRootAsReceiveLevelsResp(buf));
     });
 
     // RPC Setters
@@ -280,6 +676,13 @@ const ReceiveLevelsPage: Component = () => {
         setPriorities(emptyLevelBuffer());
         setOwners(emptyOwnerBuffer());
         setSourceMap(emptySourceMap());
+        setPacketStats(new Map<string, PacketStats>());
+        setContention(emptyContentionBuffer());
+        setJournal(null);
+        setAlertEvents([]);
+        setSnapshotDiff(null);
+        setSelectedSources([]);
+        setWhatIfPriorities(new Map<string, number>());
     });
 
     const sendFlickerFinder = (val: ReturnType<typeof flickerFinder>) => {
@@ -302,10 +705,190 @@ const ReceiveLevelsPage: Component = () => {
         setFlickers(emptyFlickerBuffer());
     });
 
+    const sendAlertRules = (val: ReturnType<typeof alertRules>) => {
+        if (ws.readyState != WebSocket.OPEN) {
+            return;
+        }
+
+        const builder = new fbsBuilder();
+        const msgRules = AlertRules.createRulesVector(builder, val.map(rule => AlertRule.createAlertRule(
+            builder, rule.id, rule.kind, rule.start, rule.count, rule.level, rule.sources,
+        )));
+        const msgAlertRules = AlertRules.createAlertRules(builder, msgRules);
+        ReceiveLevelsReq.startReceiveLevelsReq(builder);
+        ReceiveLevelsReq.addValType(builder, ReceiveLevelsReqVal.alert_rules);
+        ReceiveLevelsReq.addVal(builder, msgAlertRules);
+        const msgReceiveLevelsReq = ReceiveLevelsReq.endReceiveLevelsReq(builder);
+        builder.finish(msgReceiveLevelsReq);
+        const data = builder.asUint8Array() as Uint8Array<ArrayBuffer>;
+        ws.send(data);
+    };
+    createEffect(() => sendAlertRules(alertRules()));
+
+    const sendSnapshotReq = (action: SnapshotAction, name?: string, other?: string | null) => {
+        if (ws.readyState != WebSocket.OPEN) {
+            return;
+        }
+
+        const builder = new fbsBuilder();
+        const msgName = name === undefined ? 0 : builder.createString(name);
+        const msgOther = other === undefined || other === null ? 0 : builder.createString(other);
+        const msgSnapshotReq = SnapshotReq.createSnapshotReq(builder, action, msgName, msgOther);
+        ReceiveLevelsReq.startReceiveLevelsReq(builder);
+        ReceiveLevelsReq.addValType(builder, ReceiveLevelsReqVal.snapshot);
+        ReceiveLevelsReq.addVal(builder, msgSnapshotReq);
+        const msgReceiveLevelsReq = ReceiveLevelsReq.endReceiveLevelsReq(builder);
+        builder.finish(msgReceiveLevelsReq);
+        const data = builder.asUint8Array() as Uint8Array<ArrayBuffer>;
+        ws.send(data);
+    };
+
+    const sendJournalQuery = (address: number | null) => {
+        if (ws.readyState != WebSocket.OPEN) {
+            return;
+        }
+
+        const builder = new fbsBuilder();
+        const msgJournalQuery = JournalQuery.createJournalQuery(builder, address, 0n, 0n, JOURNAL_LIMIT);
+        ReceiveLevelsReq.startReceiveLevelsReq(builder);
+        ReceiveLevelsReq.addValType(builder, ReceiveLevelsReqVal.journal_query);
+        ReceiveLevelsReq.addVal(builder, msgJournalQuery);
+        const msgReceiveLevelsReq = ReceiveLevelsReq.endReceiveLevelsReq(builder);
+        builder.finish(msgReceiveLevelsReq);
+        const data = builder.asUint8Array() as Uint8Array<ArrayBuffer>;
+        ws.send(data);
+    };
+
+    const sendContentionFinder = (val: ReturnType<typeof contentionFinder>) => {
+        if (ws.readyState != WebSocket.OPEN) {
+            return;
+        }
+
+        const builder = new fbsBuilder();
+        const msgContentionFinder = ContentionFinder.createContentionFinder(builder, val);
+        ReceiveLevelsReq.startReceiveLevelsReq(builder);
+        ReceiveLevelsReq.addValType(builder, ReceiveLevelsReqVal.contention_finder);
+        ReceiveLevelsReq.addVal(builder, msgContentionFinder);
+        const msgReceiveLevelsReq = ReceiveLevelsReq.endReceiveLevelsReq(builder);
+        builder.finish(msgReceiveLevelsReq);
+        const data = builder.asUint8Array() as Uint8Array<ArrayBuffer>;
+        ws.send(data);
+    };
+    createEffect(() => {
+        sendContentionFinder(contentionFinder());
+        setContention(emptyContentionBuffer());
+    });
+
+    // Only ask for what is displayed.
+    const fields = createMemo(() => {
+        let val = LevelsField.Levels | LevelsField.Owners | LevelsField.Sources;
+        if (showPriorities()) {
+            val |= LevelsField.Priorities;
+        }
+        return val;
+    });
+    const sendFields = (val: ReturnType<typeof fields>) => {
+        if (ws.readyState != WebSocket.OPEN) {
+            return;
+        }
+
+        const builder = new fbsBuilder();
+        const msgFieldMask = FieldMask.createFieldMask(builder, val);
+        ReceiveLevelsReq.startReceiveLevelsReq(builder);
+        ReceiveLevelsReq.addValType(builder, ReceiveLevelsReqVal.field_mask);
+        ReceiveLevelsReq.addVal(builder, msgFieldMask);
+        const msgReceiveLevelsReq = ReceiveLevelsReq.endReceiveLevelsReq(builder);
+        builder.finish(msgReceiveLevelsReq);
+        const data = builder.asUint8Array() as Uint8Array<ArrayBuffer>;
+        ws.send(data);
+    };
+    createEffect(() => {
+        sendFields(fields());
+    });
+
+    const sendAddressWindow = (val: ReturnType<typeof addressWindow>) => {
+        if (ws.readyState != WebSocket.OPEN) {
+            return;
+        }
+
+        const builder = new fbsBuilder();
+        // An empty list asks for the whole universe.
+        AddressWindows.startRangesVector(builder, val === null ? 0 : 1);
+        if (val !== null) {
+            AddressRange.createAddressRange(builder, val[0], val[1] - val[0] + 1);
+        }
+        const msgRanges = builder.endVector();
+        const msgAddressWindows = AddressWindows.createAddressWindows(builder, msgRanges);
+        ReceiveLevelsReq.startReceiveLevelsReq(builder);
+        ReceiveLevelsReq.addValType(builder, ReceiveLevelsReqVal.address_windows);
+        ReceiveLevelsReq.addVal(builder, msgAddressWindows);
+        const msgReceiveLevelsReq = ReceiveLevelsReq.endReceiveLevelsReq(builder);
+        builder.finish(msgReceiveLevelsReq);
+        const data = builder.asUint8Array() as Uint8Array<ArrayBuffer>;
+        ws.send(data);
+    };
+    createEffect(() => {
+        sendAddressWindow(addressWindow());
+    });
+
+    const sendSourceSelection = (val: ReturnType<typeof selectedSources>) => {
+        if (ws.readyState != WebSocket.OPEN) {
+            return;
+        }
+
+        const builder = new fbsBuilder();
+        const msgCids = SourceSelection.createCidsVector(builder, val.map(cid => builder.createString(cid)));
+        const msgSourceSelection = SourceSelection.createSourceSelection(builder, msgCids);
+        ReceiveLevelsReq.startReceiveLevelsReq(builder);
+        ReceiveLevelsReq.addValType(builder, ReceiveLevelsReqVal.source_selection);
+        ReceiveLevelsReq.addVal(builder, msgSourceSelection);
+        const msgReceiveLevelsReq = ReceiveLevelsReq.endReceiveLevelsReq(builder);
+        builder.finish(msgReceiveLevelsReq);
+        const data = builder.asUint8Array() as Uint8Array<ArrayBuffer>;
+        ws.send(data);
+    };
+    createEffect(() => {
+        sendSourceSelection(selectedSources());
+        setUnmerged(emptyUnmergedMap());
+    });
+
+    const sendWhatIf = (val: ReturnType<typeof whatIfPriorities>) => {
+        if (ws.readyState != WebSocket.OPEN) {
+            return;
+        }
+
+        const builder = new fbsBuilder();
+        // An empty list stops the what-if merge.
+        const msgPriorities = WhatIf.createPrioritiesVector(builder, Array.from(val.entries()).map(
+            ([cid, priority]) => PriorityOverride.createPriorityOverride(builder, builder.createString(cid), priority),
+        ));
+        const msgWhatIf = WhatIf.createWhatIf(builder, msgPriorities);
+        ReceiveLevelsReq.startReceiveLevelsReq(builder);
+        ReceiveLevelsReq.addValType(builder, ReceiveLevelsReqVal.what_if);
+        ReceiveLevelsReq.addVal(builder, msgWhatIf);
+        const msgReceiveLevelsReq = ReceiveLevelsReq.endReceiveLevelsReq(builder);
+        builder.finish(msgReceiveLevelsReq);
+        const data = builder.asUint8Array() as Uint8Array<ArrayBuffer>;
+        ws.send(data);
+    };
+    createEffect(() => {
+        sendWhatIf(whatIfPriorities());
+        if (whatIfPriorities().size == 0) {
+            setWhatIfResult(null);
+        }
+    });
+
     // Sync settings
     createEventListener(ws, "open", () => {
+        sendFields(fields());
+        sendAddressWindow(addressWindow());
         sendUniverse(universe());
         sendFlickerFinder(flickerFinder());
+        sendContentionFinder(contentionFinder());
+        sendAlertRules(alertRules());
+        sendSnapshotReq(SnapshotAction.List);
+        sendSourceSelection(selectedSources());
+        sendWhatIf(whatIfPriorities());
     });
 
     return (
@@ -337,7 +920,34 @@ const ReceiveLevelsPage: Component = () => {
                     <Show when={universe() > 0}>
                         <>
                             <h2>{t("receiveLevels:univTitle", {val: universe()})}</h2>
-                            <SourceList sources={sources()}/>
+                            <SourceList
+                                sources={sources()}
+                                packetStats={packetStats()}
+                                selected={selectedSources()}
+                                onToggleSelected={toggleSelectedSource}
+                                whatIfPriorities={whatIfPriorities()}
+                                onWhatIfPriorityChange={setWhatIfPriority}
+                            />
+                            <AlertView
+                                rules={alertRules()}
+                                events={alertEvents()}
+                                onAdd={addAlertRule}
+                                onRemove={removeAlertRule}
+                            />
+                            <SnapshotView
+                                snapshots={snapshots()}
+                                diff={snapshotDiff()}
+                                serverTimeOffset={serverTimeOffset()}
+                                onSave={name => sendSnapshotReq(SnapshotAction.Save, name)}
+                                onDelete={name => sendSnapshotReq(SnapshotAction.Delete, name)}
+                                onDiff={(name, other) => sendSnapshotReq(SnapshotAction.Diff, name, other)}
+                            />
+                            <JournalView
+                                sourceMap={sourceMap()}
+                                entries={journal()}
+                                serverTimeOffset={serverTimeOffset()}
+                                onQuery={sendJournalQuery}
+                            />
 
                             <Stack direction="horizontal" gap={3}>
                                 <Form.Check
@@ -353,6 +963,12 @@ const ReceiveLevelsPage: Component = () => {
                                 <Button size="sm" variant="secondary" onClick={openFlickerDialog}>
                                     {t("receiveLevels:flickerFinderShowLegend", {defaultValue: "Show Legend"})}
                                 </Button>
+                                <Form.Check
+                                    label={t("receiveLevels:contentionFinderCheck")}
+                                    title={t("receiveLevels:contentionFinderTitle")}
+                                    checked={contentionFinder()}
+                                    onChange={() => setContentionFinder(!contentionFinder())}
+                                />
 
                             </Stack>
 
@@ -385,10 +1001,33 @@ const ReceiveLevelsPage: Component = () => {
                                             owners={owners()}
                                             colors={addressColors()}
                                             showPriorities={showPriorities()}
+                                            onAddressWindowChange={setAddressWindow}
                                         />
                                     </Show>
                                 </Tab>
                             </Tabs>
+
+                            <Show when={whatIfResult()}>
+                                {(result) => (
+                                    <WhatIfView
+                                        sourceMap={sourceMap()}
+                                        result={result()}
+                                        viewMode={viewMode()}
+                                        showPriorities={showPriorities()}
+                                    />
+                                )}
+                            </Show>
+
+                            <For each={selectedSources()}>
+                                {(cid) => (
+                                    <UnmergedView
+                                        source={sourceMap().get(cid) ?? {...DEFAULT_SOURCE, cid: cid, color: colorForCID(cid)}}
+                                        levels={unmerged().get(cid)}
+                                        viewMode={viewMode()}
+                                        showPriorities={showPriorities()}
+                                    />
+                                )}
+                            </For>
                         </>
                     </Show>
 
@@ -450,6 +1089,14 @@ const UnivDialog: Component<UnivDialogProps> = (props) => {
 
 interface SourceListProps {
     sources: Source[];
+    /** Packet counts by CID. */
+    packetStats: Map<string, PacketStats>;
+    /** CIDs of sources shown unmerged. */
+    selected: string[];
+    onToggleSelected: (cid: string) => void;
+    /** Priorities to merge sources with, by CID. 0 leaves the source out. */
+    whatIfPriorities: Map<string, number>;
+    onWhatIfPriorityChange: (cid: string, priority: number | null) => void;
 }
 
 const SourceList: Component<SourceListProps> = (props) => {
@@ -479,6 +1126,13 @@ const SourceList: Component<SourceListProps> = (props) => {
                                     <th>{t("receiveLevels:sourceList.sourceName")}</th>
                                     <th>{t("receiveLevels:sourceList.sourceIpAddress")}</th>
                                     <th>{t("receiveLevels:sourceList.sourcePriority")}</th>
+                                    <th title={t("receiveLevels:sourceList.packetsTitle")}>
+                                        {t("receiveLevels:sourceList.packetsLost")}
+                                        &nbsp;/&nbsp;{t("receiveLevels:sourceList.packetsDuplicated")}
+                                        &nbsp;/&nbsp;{t("receiveLevels:sourceList.packetsOutOfOrder")}
+                                    </th>
+                                    <th>{t("receiveLevels:sourceList.sourceUnmerged")}</th>
+                                    <th>{t("receiveLevels:sourceList.sourceWhatIf")}</th>
                                 </tr>
                                 </thead>
                                 <tbody>
@@ -493,6 +1147,34 @@ const SourceList: Component<SourceListProps> = (props) => {
                                                     {t("receiveLevels:sourceList.papPriority", {val: source.priority})}
                                                 </Show>
                                             </td>
+                                            <td>
+                                                <Show when={props.packetStats.get(source.cid)}>
+                                                    {(stats) => `${stats().lost} / ${stats().duplicated} / ${stats().outOfOrder}`}
+                                                </Show>
+                                            </td>
+                                            <td>
+                                                <Form.Check
+                                                    aria-label={t("receiveLevels:sourceList.sourceUnmerged")}
+                                                    checked={props.selected.includes(source.cid)}
+                                                    onChange={() => props.onToggleSelected(source.cid)}
+                                                />
+                                            </td>
+                                            <td>
+                                                <Form.Control
+                                                    type="number"
+                                                    size="sm"
+                                                    min={0}
+                                                    max={200}
+                                                    aria-label={t("receiveLevels:sourceList.sourceWhatIf")}
+                                                    placeholder={`${source.priority}`}
+                                                    value={props.whatIfPriorities.get(source.cid) ?? ""}
+                                                    onChange={e => {
+                                                        const input = e.currentTarget as HTMLInputElement;
+                                                        // Clearing the box stops overriding this source.
+                                                        props.onWhatIfPriorityChange(source.cid, clamp(input.valueAsNumber, 0, 200) ?? null);
+                                                    }}
+                                                />
+                                            </td>
                                         </tr>
                                     )}
                                 </For>
@@ -509,6 +1191,347 @@ const SourceList: Component<SourceListProps> = (props) => {
     );
 };
 
+const describeAlertRule = (rule: ClientAlertRule) => {
+    const vals = {start: rule.start + 1, end: rule.start + rule.count, level: rule.level, sources: rule.sources};
+    switch (rule.kind) {
+        case AlertKind.LevelAbove:
+            return t("receiveLevels:alerts.rule.levelAbove", vals);
+        case AlertKind.Changed:
+            return t("receiveLevels:alerts.rule.changed", vals);
+        case AlertKind.SourcesBelow:
+            return t("receiveLevels:alerts.rule.sourcesBelow", vals);
+    }
+};
+
+interface AlertViewProps {
+    rules: ClientAlertRule[];
+    /** Newest first. */
+    events: ClientAlertEvent[];
+    onAdd: (rule: Omit<ClientAlertRule, "id">) => void;
+    onRemove: (id: number) => void;
+}
+
+const AlertView: Component<AlertViewProps> = (props) => {
+    const accordianId = createUniqueId();
+    const [kind, setKind] = createSignal(AlertKind.LevelAbove);
+    let startInputRef!: HTMLInputElement;
+    let endInputRef!: HTMLInputElement;
+    let valueInputRef!: HTMLInputElement;
+    const onSubmit = () => {
+        const start = clamp(startInputRef?.valueAsNumber ?? NaN, 1, DMX_MAX, 1);
+        const end = clamp(endInputRef?.valueAsNumber ?? NaN, start, DMX_MAX, start);
+        const value = clamp(valueInputRef?.valueAsNumber ?? NaN, 0, 255, 0);
+        props.onAdd({
+            kind: kind(),
+            start: start - 1,
+            count: end - start + 1,
+            level: value,
+            sources: value,
+        });
+    };
+    const activeRules = createMemo(() => {
+        // Events are newest first, so the first one seen for each rule is its current state.
+        const seen = new Set<number>();
+        const active = new Set<number>();
+        for (const event of props.events) {
+            if (!seen.has(event.rule.id)) {
+                seen.add(event.rule.id);
+                if (event.active) {
+                    active.add(event.rule.id);
+                }
+            }
+        }
+        return active;
+    });
+
+    return (
+        <Accordion class="mt-3">
+            <Accordion.Item eventKey={accordianId}>
+                <Accordion.Header>
+                    {t("receiveLevels:alerts.title")}&nbsp;
+                    <Badge bg={activeRules().size > 0 ? "danger" : "secondary"}>{activeRules().size}</Badge>
+                </Accordion.Header>
+                <Accordion.Body>
+                    <Form class="mb-3" onSubmit={e => {
+                        e.preventDefault();
+                        onSubmit();
+                    }}>
+                        <Stack direction="horizontal" gap={3}>
+                            <FloatingLabel label={t("receiveLevels:alerts.form.kind")}>
+                                <Form.Select
+                                    value={kind()}
+                                    onChange={e => setKind(Number(e.currentTarget.value) as AlertKind)}
+                                >
+                                    <option value={AlertKind.LevelAbove}>{t("receiveLevels:alerts.kind.levelAbove")}</option>
+                                    <option value={AlertKind.Changed}>{t("receiveLevels:alerts.kind.changed")}</option>
+                                    <option value={AlertKind.SourcesBelow}>{t("receiveLevels:alerts.kind.sourcesBelow")}</option>
+                                </Form.Select>
+                            </FloatingLabel>
+                            <Show when={kind() != AlertKind.SourcesBelow}>
+                                <FloatingLabel label={t("receiveLevels:alerts.form.start")}>
+                                    <Form.Control type="number" min={1} max={DMX_MAX} ref={startInputRef}/>
+                                </FloatingLabel>
+                                <FloatingLabel label={t("receiveLevels:alerts.form.end")}>
+                                    <Form.Control type="number" min={1} max={DMX_MAX} ref={endInputRef}/>
+                                </FloatingLabel>
+                            </Show>
+                            <Show when={kind() != AlertKind.Changed}>
+                                <FloatingLabel label={kind() == AlertKind.SourcesBelow
+                                    ? t("receiveLevels:alerts.form.sources")
+                                    : t("receiveLevels:alerts.form.level")}>
+                                    <Form.Control type="number" min={0} max={255} ref={valueInputRef}/>
+                                </FloatingLabel>
+                            </Show>
+                            <Button variant="primary" onClick={onSubmit}>{t("receiveLevels:alerts.add")}</Button>
+                        </Stack>
+                    </Form>
+                    <Table size="sm">
+                        <tbody>
+                        <For each={props.rules}>
+                            {(rule) => (
+                                <tr classList={{"table-danger": activeRules().has(rule.id)}}>
+                                    <td>{describeAlertRule(rule)}</td>
+                                    <td>
+                                        <Button size="sm" variant="outline-secondary" onClick={() => props.onRemove(rule.id)}>
+                                            {t("receiveLevels:alerts.remove")}
+                                        </Button>
+                                    </td>
+                                </tr>
+                            )}
+                        </For>
+                        </tbody>
+                    </Table>
+                    <Show when={props.events.length > 0} fallback={t("receiveLevels:alerts.empty")}>
+                        <ul class="list-unstyled">
+                            <For each={props.events}>
+                                {(event) => (
+                                    <li classList={{"text-danger": event.active}}>
+                                        <Show when={event.active} fallback={t("receiveLevels:alerts.event.cleared", {rule: describeAlertRule(event.rule)})}>
+                                            <Show when={event.address !== null} fallback={describeAlertRule(event.rule)}>
+                                                {t("receiveLevels:alerts.event.address", {
+                                                    rule: describeAlertRule(event.rule),
+                                                    address: event.address! + 1,
+                                                    level: event.level,
+                                                })}
+                                            </Show>
+                                        </Show>
+                                    </li>
+                                )}
+                            </For>
+                        </ul>
+                    </Show>
+                </Accordion.Body>
+            </Accordion.Item>
+        </Accordion>
+    );
+};
+
+interface SnapshotViewProps {
+    snapshots: SnapshotEntry[];
+    diff: SnapshotDiffResult | null;
+    /** Server time - local time. */
+    serverTimeOffset: bigint;
+    onSave: (name: string) => void;
+    onDelete: (name: string) => void;
+    /** Compare @p name with @p other, or with the current levels if @p other is null. */
+    onDiff: (name: string, other: string | null) => void;
+}
+
+const SnapshotView: Component<SnapshotViewProps> = (props) => {
+    const accordianId = createUniqueId();
+    let nameInputRef!: HTMLInputElement;
+    const [compareWith, setCompareWith] = createSignal<string | null>(null);
+    const onSubmit = () => {
+        const name = nameInputRef.value.trim();
+        if (name.length > 0) {
+            props.onSave(name);
+            nameInputRef.value = "";
+        }
+    };
+
+    return (
+        <Accordion class="mt-3">
+            <Accordion.Item eventKey={accordianId}>
+                <Accordion.Header>
+                    {t("receiveLevels:snapshots.title")}&nbsp;<Badge bg="secondary">{props.snapshots.length}</Badge>
+                </Accordion.Header>
+                <Accordion.Body>
+                    <Form class="mb-3" onSubmit={e => {
+                        e.preventDefault();
+                        onSubmit();
+                    }}>
+                        <Stack direction="horizontal" gap={3}>
+                            <FloatingLabel label={t("receiveLevels:snapshots.name")}>
+                                <Form.Control type="text" maxLength={64} ref={nameInputRef}/>
+                            </FloatingLabel>
+                            <Button variant="primary" onClick={onSubmit}>{t("receiveLevels:snapshots.save")}</Button>
+                            <FloatingLabel label={t("receiveLevels:snapshots.compareWith")}>
+                                <Form.Select
+                                    value={compareWith() ?? ""}
+                                    onChange={e => setCompareWith(e.currentTarget.value == "" ? null : e.currentTarget.value)}
+                                >
+                                    <option value="">{t("receiveLevels:snapshots.live")}</option>
+                                    <For each={props.snapshots}>
+                                        {(snapshot) => <option value={snapshot.name}>{snapshot.name}</option>}
+                                    </For>
+                                </Form.Select>
+                            </FloatingLabel>
+                        </Stack>
+                    </Form>
+                    <Show when={props.snapshots.length > 0} fallback={t("receiveLevels:snapshots.empty")}>
+                        <Table size="sm">
+                            <thead>
+                            <tr>
+                                <th>{t("receiveLevels:snapshots.heading.name")}</th>
+                                <th>{t("receiveLevels:snapshots.heading.universe")}</th>
+                                <th>{t("receiveLevels:snapshots.heading.time")}</th>
+                                <th/>
+                            </tr>
+                            </thead>
+                            <tbody>
+                            <For each={props.snapshots}>
+                                {(snapshot) => (
+                                    <tr>
+                                        <td>{snapshot.name}</td>
+                                        <td>{snapshot.universe}</td>
+                                        <td>{new Date(Number(snapshot.timestamp - props.serverTimeOffset)).toLocaleString()}</td>
+                                        <td>
+                                            <Stack direction="horizontal" gap={1}>
+                                                <Button size="sm" variant="secondary"
+                                                        onClick={() => props.onDiff(snapshot.name, compareWith())}>
+                                                    {t("receiveLevels:snapshots.compare")}
+                                                </Button>
+                                                <Button size="sm" variant="outline-danger"
+                                                        onClick={() => props.onDelete(snapshot.name)}>
+                                                    {t("receiveLevels:snapshots.delete")}
+                                                </Button>
+                                            </Stack>
+                                        </td>
+                                    </tr>
+                                )}
+                            </For>
+                            </tbody>
+                        </Table>
+                    </Show>
+                    <Show when={props.diff}>
+                        {(diff) => (
+                            <Switch>
+                                <Match when={diff().status === SnapshotDiffStatus.NotFound}>
+                                    {t("receiveLevels:snapshots.notFound")}
+                                </Match>
+                                <Match when={diff().status === SnapshotDiffStatus.NoLevels}>
+                                    {t("receiveLevels:snapshots.noLevels", {universe: diff().universe})}
+                                </Match>
+                                <Match when={diff().status === SnapshotDiffStatus.Ok}>
+                                    <h4>{t("receiveLevels:snapshots.diffTitle", {
+                                        name: diff().name,
+                                        universe: diff().universe,
+                                        other: diff().other ?? t("receiveLevels:snapshots.live"),
+                                        otherUniverse: diff().otherUniverse,
+                                    })}</h4>
+                                    <Show when={diff().runs.length > 0} fallback={t("receiveLevels:snapshots.noDifferences")}>
+                                        <ul class="list-unstyled">
+                                            <For each={diff().runs}>
+                                                {(run) => (
+                                                    <li>
+                                                        {t("receiveLevels:snapshots.diffRun", {
+                                                            start: run.start + 1,
+                                                            end: run.start + run.levels.length,
+                                                            levels: run.levels.join(" "),
+                                                            otherLevels: run.otherLevels.join(" "),
+                                                        })}
+                                                    </li>
+                                                )}
+                                            </For>
+                                        </ul>
+                                    </Show>
+                                </Match>
+                            </Switch>
+                        )}
+                    </Show>
+                </Accordion.Body>
+            </Accordion.Item>
+        </Accordion>
+    );
+};
+
+interface JournalViewProps {
+    sourceMap: Map<string, Source>;
+    /** Changes from the last query, newest first, or null before the first query. */
+    entries: JournalEntry[] | null;
+    /** Server time - local time. */
+    serverTimeOffset: bigint;
+    /** Ask for changes to an address (starting from 0), or to every address. */
+    onQuery: (address: number | null) => void;
+}
+
+const JournalView: Component<JournalViewProps> = (props) => {
+    const accordianId = createUniqueId();
+    let addressInputRef!: HTMLInputElement;
+    const onSubmit = () => {
+        // Blank for every address.
+        const address = clamp(addressInputRef.valueAsNumber, 1, DMX_MAX);
+        props.onQuery(address === undefined ? null : address - 1);
+    };
+
+    return (
+        <Accordion class="mt-3">
+            <Accordion.Item eventKey={accordianId}>
+                <Accordion.Header>
+                    {t("receiveLevels:journal.title")}
+                </Accordion.Header>
+                <Accordion.Body>
+                    <Form class="mb-3" onSubmit={e => {
+                        e.preventDefault();
+                        onSubmit();
+                    }}>
+                        <Stack direction="horizontal" gap={3}>
+                            <FloatingLabel label={t("receiveLevels:journal.address")}>
+                                <Form.Control
+                                    type="number"
+                                    min={1}
+                                    max={DMX_MAX}
+                                    placeholder={t("receiveLevels:journal.allAddresses")}
+                                    ref={addressInputRef}
+                                />
+                            </FloatingLabel>
+                            <Button variant="primary" onClick={onSubmit}>{t("receiveLevels:journal.submit")}</Button>
+                        </Stack>
+                    </Form>
+                    <Show when={props.entries}>
+                        {(entries) => (
+                            <Show when={entries().length > 0} fallback={t("receiveLevels:journal.empty")}>
+                                <Table size="sm">
+                                    <thead>
+                                    <tr>
+                                        <th>{t("receiveLevels:journal.heading.time")}</th>
+                                        <th>{t("receiveLevels:journal.heading.address")}</th>
+                                        <th>{t("receiveLevels:journal.heading.change")}</th>
+                                        <th>{t("receiveLevels:journal.heading.owner")}</th>
+                                    </tr>
+                                    </thead>
+                                    <tbody>
+                                    <For each={entries()}>
+                                        {(entry) => (
+                                            <tr>
+                                                <td>{new Date(Number(entry.timestamp - props.serverTimeOffset)).toLocaleTimeString()}</td>
+                                                <td>{entry.address + 1}</td>
+                                                <td>{t("receiveLevels:journal.change", {old: entry.oldLevel, new: entry.newLevel})}</td>
+                                                <td>{props.sourceMap.get(entry.owner)?.name ?? entry.owner}</td>
+                                            </tr>
+                                        )}
+                                    </For>
+                                    </tbody>
+                                </Table>
+                            </Show>
+                        )}
+                    </Show>
+                </Accordion.Body>
+            </Accordion.Item>
+        </Accordion>
+    );
+};
+
 interface LevelsViewProps {
     sourceMap: Map<string, Source>;
     levels: number[];
@@ -516,6 +1539,8 @@ interface LevelsViewProps {
     owners: string[];
     colors: CidColor[];
     showPriorities: boolean;
+    /** Called with the addresses in view, or null when every address should be updated. */
+    onAddressWindowChange?: (window: AddressWindow | null) => void;
 }
 
 const ViewGridTitle: Component = () => {
@@ -625,23 +1650,128 @@ const ViewBars: Component<LevelsViewProps> = (props) => {
         return props.colors.map(color => color.dark ?? DEFAULT_SOURCE.color.dark);
     });
 
+    // Track which bars are on screen so the server only sends those. Bars within a screen's height
+    // count as visible, so they are already filled in when scrolled to.
+    const visible = new Set<number>();
+    const observer = new IntersectionObserver(entries => {
+        for (const entry of entries) {
+            const addr = Number((entry.target as HTMLElement).dataset.address);
+            if (entry.isIntersecting) {
+                visible.add(addr);
+            } else {
+                visible.delete(addr);
+            }
+        }
+        if (visible.size > 0) {
+            props.onAddressWindowChange?.([Math.min(...visible), Math.max(...visible)]);
+        }
+    }, {rootMargin: "100% 0px"});
+    onCleanup(() => {
+        observer.disconnect();
+        props.onAddressWindowChange?.(null);
+    });
+
     return (
         <Stack class="msacn-viewbars" direction="vertical" gap={1}>
             <Index each={props.levels}>
                 {(level, addr) => (
-                    <LevelBar
-                        label={`${addr + 1}`.padStart(3, "0")}
-                        level={level()}
-                        priority={props.showPriorities ? props.priorities[addr] : undefined}
-                        color={fgColors()[addr]}
-                        bgColor={bgColors()[addr]}
-                    />
+                    <div data-address={addr} ref={el => observer.observe(el)}>
+                        <LevelBar
+                            label={`${addr + 1}`.padStart(3, "0")}
+                            level={level()}
+                            priority={props.showPriorities ? props.priorities[addr] : undefined}
+                            color={fgColors()[addr]}
+                            bgColor={bgColors()[addr]}
+                        />
+                    </div>
                 )}
             </Index>
         </Stack>
     );
 };
 
+interface UnmergedViewProps {
+    source: Source;
+    levels?: UnmergedLevels;
+    viewMode: ViewMode;
+    showPriorities: boolean;
+}
+
+/**
+ * One source's own levels, as if it was the only source.
+ */
+const UnmergedView: Component<UnmergedViewProps> = (props) => {
+    const sourceMap = createMemo(() => new Map([[props.source.cid, props.source]]));
+    const levels = createMemo(() => props.levels?.levels ?? emptyLevelBuffer());
+    const priorities = createMemo(() => props.levels?.priorities ?? emptyLevelBuffer());
+    const owners = createMemo(() => priorities().map(priority => priority > 0 ? props.source.cid : ""));
+    const colors = createMemo(() => owners().map(cid => cid == "" ? DEFAULT_SOURCE.color : props.source.color));
+
+    return (
+        <>
+            <h3 class="mt-3">{t("receiveLevels:unmergedTitle", {name: props.source.name})}</h3>
+            <Show when={props.viewMode == ViewMode.GRID} fallback={
+                <ViewBars
+                    sourceMap={sourceMap()}
+                    levels={levels()}
+                    priorities={priorities()}
+                    owners={owners()}
+                    colors={colors()}
+                    showPriorities={props.showPriorities}
+                />
+            }>
+                <ViewGrid
+                    sourceMap={sourceMap()}
+                    levels={levels()}
+                    priorities={priorities()}
+                    owners={owners()}
+                    colors={colors()}
+                    showPriorities={props.showPriorities}
+                />
+            </Show>
+        </>
+    );
+};
+
+interface WhatIfViewProps {
+    sourceMap: Map<string, Source>;
+    result: WhatIfResult;
+    viewMode: ViewMode;
+    showPriorities: boolean;
+}
+
+/**
+ * Merged levels as if sources had the priorities the user chose.
+ */
+const WhatIfView: Component<WhatIfViewProps> = (props) => {
+    const colors = createMemo(() => props.result.owners.map(cid => (props.sourceMap.get(cid) ?? DEFAULT_SOURCE).color));
+
+    return (
+        <>
+            <h3 class="mt-3">{t("receiveLevels:whatIfTitle")}</h3>
+            <Show when={props.viewMode == ViewMode.GRID} fallback={
+                <ViewBars
+                    sourceMap={props.sourceMap}
+                    levels={props.result.levels}
+                    priorities={props.result.priorities}
+                    owners={props.result.owners}
+                    colors={colors()}
+                    showPriorities={props.showPriorities}
+                />
+            }>
+                <ViewGrid
+                    sourceMap={props.sourceMap}
+                    levels={props.result.levels}
+                    priorities={props.result.priorities}
+                    owners={props.result.owners}
+                    colors={colors()}
+                    showPriorities={props.showPriorities}
+                />
+            </Show>
+        </>
+    );
+};
+
 interface FlickerDialogProps {
     onClose: () => void;
 }
@@ -44,14 +44,14 @@ Application::~Application()
     etcPalLogger_.Shutdown();
 }
 
-void Application::start(const Options &options)
+bool Application::start(const Options &options)
 {
     // Tell the CID generator about the sACN interface's MAC Address.
     auto sacnNetInterface = etcpal::netint::GetInterfaceWithIp(
         etcpal::IpAddr::FromString(options.sacn_address));
     if (!sacnNetInterface) {
         SPDLOG_CRITICAL("Could not get network interface for sACN.");
-        return;
+        return false;
     }
     SacnCidGenerator::get().setMacAddress(sacnNetInterface->mac());
 
@@ -72,17 +72,25 @@ void Application::start(const Options &options)
         HttpServer::Options{
             .backend_address = options.backend_address,
             .sacn_interface = *sacnNetInterface,
+            .port = options.http_port.value_or(HttpServer::kDefaultPort),
+            .worker_threads = options.worker_threads,
         },
         this);
     connect(httpServer_, &HttpServer::handlerStarted, this, &Application::handlerStarted);
     connect(httpServer_, &HttpServer::handlerStopped, this, &Application::handlerStopped);
 
-    httpServer_->run();
+    if (!httpServer_->run()) {
+        delete httpServer_;
+        httpServer_ = nullptr;
+        return false;
+    }
 
     // Setup sACN Source Detector
     handler::SourceDetector::get()->startup();
+    handler::MergeReceiverPool::get()->startup(options.receiver_pool);
 
     Q_EMIT(started());
+    return true;
 }
 
 void Application::stop()
@@ -93,6 +101,7 @@ void Application::stop()
         httpServer_->deleteLater();
         httpServer_ = nullptr;
     }
+    handler::MergeReceiverPool::get()->shutdown();
     Q_EMIT(stopped());
 }
 
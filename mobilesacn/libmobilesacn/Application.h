@@ -12,8 +12,10 @@
 #define CROW_DISABLE_STATIC_DIR
 
 #include "EtcPalLogHandler.h"
+#include "handler/MergeReceiverPool.h"
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <string>
 #include <QHostAddress>
 #include <QObject>
@@ -32,12 +34,22 @@ public:
     {
         std::string backend_address;
         std::string sacn_address;
+        /** Port serving the Web UI. Uses the default port if not set. */
+        std::optional<uint16_t> http_port;
+        /** Number of threads running web handlers, or 0 to use one per core. */
+        unsigned int worker_threads = 0;
+        handler::MergeReceiverPool::Options receiver_pool;
     };
 
     explicit Application(QObject *parent = nullptr);
     ~Application() override;
 
-    void start(const Options &options);
+    /**
+     * Start serving clients.
+     *
+     * @return If the application started.
+     */
+    bool start(const Options &options);
     void stop();
     bool isRunning() const { return httpServer_ != nullptr; }
     [[nodiscard]] QString getWebUrl() const;
@@ -7,9 +7,10 @@
  */
 
 #include "Caffeine.h"
+#include "mobilesacn_config.h"
 #include <spdlog/spdlog.h>
 #include <unistd.h>
-#include <QApplication>
+#include <QCoreApplication>
 #include <QDBusInterface>
 #include <QDBusMessage>
 #include <QDBusUnixFileDescriptor>
@@ -28,8 +29,8 @@ void Caffeine::setActive(const bool active)
         const auto inhibitHandle = fdLoginManager.call(
             "Inhibit",
             "sleep:idle",
-            qApp->applicationDisplayName(),
-            qApp->translate("Caffeine", "Application is handling clients"),
+            QString::fromUtf8(config::kProjectDisplayName),
+            QCoreApplication::translate("Caffeine", "Application is handling clients"),
             "block");
         if (fdLoginManager.lastError().isValid()) {
             const auto err = fdLoginManager.lastError();
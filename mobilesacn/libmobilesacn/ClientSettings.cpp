@@ -7,6 +7,9 @@
  */
 
 #include "ClientSettings.h"
+#include "web_asset.h"
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
 #include <QJsonObject>
 #include <QJsonValue>
 #include <QSet>
@@ -102,4 +105,82 @@ void ClientSettings::save() const
     Settings::sync();
 }
 
+ClientSettingsStore::ClientSettingsStore(QObject *parent) :
+    QObject(parent), snapshot_(makeSnapshot(ClientSettings())), writeTimer_(new QTimer)
+{
+    writerThread_.setObjectName(QStringLiteral("ClientSettingsWriter"));
+    writeTimer_->setSingleShot(true);
+    writeTimer_->setInterval(kWriteDelay);
+    writeTimer_->moveToThread(&writerThread_);
+    connect(writeTimer_, &QTimer::timeout, writeTimer_, [this]() { writePending(); });
+    connect(&writerThread_, &QThread::finished, writeTimer_, &QObject::deleteLater);
+    writerThread_.start();
+}
+
+ClientSettingsStore::~ClientSettingsStore()
+{
+    stop();
+}
+
+ClientSettingsStore::SnapshotPtr ClientSettingsStore::snapshot() const
+{
+    std::scoped_lock lock(mutex_);
+    return snapshot_;
+}
+
+void ClientSettingsStore::update(ClientSettings settings)
+{
+    {
+        std::scoped_lock lock(mutex_);
+        if (settings == snapshot_->settings) {
+            return;
+        }
+        snapshot_ = makeSnapshot(settings);
+        pending_ = std::move(settings);
+    }
+    // Restart the timer, so a burst of changes is only written once.
+    QMetaObject::invokeMethod(writeTimer_, qOverload<>(&QTimer::start));
+}
+
+void ClientSettingsStore::stop()
+{
+    if (!writerThread_.isRunning()) {
+        return;
+    }
+    QMetaObject::invokeMethod(
+        writeTimer_,
+        [this]() {
+            writeTimer_->stop();
+            writePending();
+        },
+        Qt::BlockingQueuedConnection);
+    writerThread_.quit();
+    writerThread_.wait();
+}
+
+ClientSettingsStore::SnapshotPtr ClientSettingsStore::makeSnapshot(ClientSettings settings)
+{
+    auto json = QJsonDocument(settings.toJson()).toJson(QJsonDocument::Compact);
+    auto etag = fmt::format(
+        "\"{}\"", webasset::contentHash(std::string_view(json.constData(), json.size())));
+    return std::make_shared<const Snapshot>(Snapshot{
+        .settings = std::move(settings),
+        .json = std::move(json),
+        .etag = std::move(etag),
+    });
+}
+
+void ClientSettingsStore::writePending()
+{
+    std::optional<ClientSettings> settings;
+    {
+        std::scoped_lock lock(mutex_);
+        settings.swap(pending_);
+    }
+    if (settings) {
+        SPDLOG_DEBUG("Saving client settings");
+        settings->save();
+    }
+}
+
 } // namespace mobilesacn
@@ -9,9 +9,15 @@
 #ifndef MOBILESACN_LIBMOBILESACN_CLIENTSETTINGS_H
 #define MOBILESACN_LIBMOBILESACN_CLIENTSETTINGS_H
 
+#include <chrono>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <string>
 #include <QJsonDocument>
 #include <QString>
+#include <QThread>
+#include <QTimer>
 
 namespace mobilesacn {
 
@@ -43,11 +49,66 @@ public:
      */
     void save() const;
 
+    bool operator==(const ClientSettings &) const = default;
+
 private:
     std::optional<QString> preferredColorMode_;
     std::optional<QString> levelDisplayMode_;
 };
 
+/**
+ * In-memory copy of the client settings, so serving them never touches the config file.
+ *
+ * Changes are written to the system in the background, once they stop arriving.
+ */
+class ClientSettingsStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Snapshot
+    {
+        ClientSettings settings;
+        /** Compact JSON, ready to send. */
+        QByteArray json;
+        /** Strong ETag for #json, including quotes. */
+        std::string etag;
+    };
+    using SnapshotPtr = std::shared_ptr<const Snapshot>;
+
+    /**
+     * Load settings from system.
+     */
+    explicit ClientSettingsStore(QObject *parent = nullptr);
+    ~ClientSettingsStore() override;
+
+    [[nodiscard]] SnapshotPtr snapshot() const;
+
+    /**
+     * Replace the current settings, and schedule them to be saved.
+     */
+    void update(ClientSettings settings);
+
+    /**
+     * Save any pending changes and stop the background writer.
+     */
+    void stop();
+
+private:
+    static constexpr auto kWriteDelay = std::chrono::milliseconds(500);
+
+    mutable std::mutex mutex_;
+    SnapshotPtr snapshot_;
+    /** Settings not yet saved to system. */
+    std::optional<ClientSettings> pending_;
+    QThread writerThread_;
+    /** Lives on #writerThread_. */
+    QTimer *writeTimer_;
+
+    static SnapshotPtr makeSnapshot(ClientSettings settings);
+    void writePending();
+};
+
 } // namespace mobilesacn
 
 #endif //MOBILESACN_LIBMOBILESACN_CLIENTSETTINGS_H
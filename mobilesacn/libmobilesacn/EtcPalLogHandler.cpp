@@ -34,8 +34,13 @@ void EtcPalLogHandler::HandleLogMessage(const EtcPalLogStrings &strings) {
     return spdlog::level::err;
   }();
 
-  // Do the thing.
-  spdlog::log(level, strings.raw);
+  // Don't bother queueing messages that will be thrown away.
+  if (!spdlog::should_log(level)) {
+    return;
+  }
+
+  // Do the thing. The message is not a format string, so it must not be treated as one.
+  spdlog::log(level, "{}", strings.raw);
 }
 
 } // mobilesacn
@@ -35,4 +35,9 @@ BaseHandler *createWebHandler(QWebSocket *ws, QObject *parent)
     return (*factory)(ws, parent);
 }
 
+bool hasWebHandler(const QString &path)
+{
+    return HANDLERS.contains(path);
+}
+
 } // namespace mobilesacn
@@ -22,6 +22,11 @@ namespace mobilesacn {
  * @return A handler object, or nullptr if no handler could be found.
  */
 BaseHandler *createWebHandler(QWebSocket *ws, QObject *parent);
+
+/**
+ * Check if a handler exists for websocket connections to @p path.
+ */
+bool hasWebHandler(const QString &path);
 } // namespace mobilesacn
 
 #endif //MOBILESACN_LIBMOBILESACN_HANDLERFACTORY_H
@@ -0,0 +1,81 @@
+/**
+ * @file HandlerWorkerPool.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "HandlerWorkerPool.h"
+#include "HandlerFactory.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace mobilesacn {
+
+HandlerWorkerPool::HandlerWorkerPool(unsigned int threadCount, QObject *parent) :
+    QObject(parent)
+{
+    if (threadCount == 0) {
+        threadCount = std::max(QThread::idealThreadCount(), 1);
+    }
+    SPDLOG_DEBUG("Starting {} handler worker threads", threadCount);
+    for (unsigned int ix = 0; ix < threadCount; ++ix) {
+        auto &worker = workers_.emplace_back(std::make_unique<Worker>());
+        worker->thread.setObjectName(QStringLiteral("HandlerWorker%1").arg(ix));
+        worker->context = new QObject;
+        worker->context->moveToThread(&worker->thread);
+        // Deleting the context deletes any handlers still running on this worker.
+        connect(&worker->thread, &QThread::finished, worker->context, &QObject::deleteLater);
+        worker->thread.start();
+    }
+}
+
+HandlerWorkerPool::~HandlerWorkerPool()
+{
+    stop();
+}
+
+void HandlerWorkerPool::dispatch(QWebSocket *ws, CreatedCallback onCreated)
+{
+    auto &worker = leastBusyWorker();
+    // Count the handler now so a burst of connections is spread across workers.
+    ++worker.handlerCount;
+
+    ws->setParent(nullptr);
+    ws->moveToThread(&worker.thread);
+    QMetaObject::invokeMethod(
+        worker.context, [ws, &worker, onCreated = std::move(onCreated)]() {
+            auto handler = createWebHandler(ws, worker.context);
+            if (!handler) {
+                SPDLOG_WARN(
+                    "Unsupported websocket path: {}", ws->requestUrl().path().toStdString());
+                --worker.handlerCount;
+                ws->close();
+                ws->deleteLater();
+                return;
+            }
+            connect(handler, &QObject::destroyed, [&worker]() { --worker.handlerCount; });
+            onCreated(handler, ws);
+        });
+}
+
+void HandlerWorkerPool::stop()
+{
+    for (auto &worker : workers_) {
+        if (worker->thread.isRunning()) {
+            worker->thread.quit();
+            worker->thread.wait();
+        }
+    }
+}
+
+HandlerWorkerPool::Worker &HandlerWorkerPool::leastBusyWorker()
+{
+    Q_ASSERT(!workers_.empty());
+    return **std::ranges::min_element(workers_, {}, [](const auto &worker) {
+        return worker->handlerCount.load(std::memory_order_relaxed);
+    });
+}
+
+} // namespace mobilesacn
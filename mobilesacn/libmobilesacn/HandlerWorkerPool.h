@@ -0,0 +1,72 @@
+/**
+ * @file HandlerWorkerPool.h
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#ifndef MOBILESACN_LIBMOBILESACN_HANDLERWORKERPOOL_H
+#define MOBILESACN_LIBMOBILESACN_HANDLERWORKERPOOL_H
+
+#include "handler/BaseHandler.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <QThread>
+#include <QWebSocket>
+
+namespace mobilesacn {
+
+/**
+ * Run web handlers on a pool of worker threads, each with its own event loop.
+ *
+ * A handler, its websocket, and any MergeReceiver subscriptions it makes all live on the same
+ * worker, so a slow client or a stalled GUI thread only affects the handlers sharing that worker.
+ */
+class HandlerWorkerPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    using CreatedCallback = std::function<void(BaseHandler *handler, QWebSocket *ws)>;
+
+    /**
+     * @param threadCount Number of worker threads, or 0 to use one per core.
+     * @param parent
+     */
+    explicit HandlerWorkerPool(unsigned int threadCount = 0, QObject *parent = nullptr);
+    ~HandlerWorkerPool() override;
+
+    /**
+     * Move @p ws to the least busy worker and create its handler there.
+     *
+     * @param ws Connected websocket. The pool takes ownership.
+     * @param onCreated Called on the worker thread once the handler has been created. Not called
+     * if no handler supports the websocket's path.
+     */
+    void dispatch(QWebSocket *ws, CreatedCallback onCreated);
+
+    /**
+     * Stop all workers, deleting any remaining handlers.
+     */
+    void stop();
+
+private:
+    struct Worker
+    {
+        QThread thread;
+        /** Lives on #thread and parents every handler created there. */
+        QObject *context = nullptr;
+        std::atomic<int> handlerCount{0};
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    Worker &leastBusyWorker();
+};
+
+} // namespace mobilesacn
+
+#endif //MOBILESACN_LIBMOBILESACN_HANDLERWORKERPOOL_H
@@ -0,0 +1,341 @@
+/**
+ * @file HttpConnection.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "HttpConnection.h"
+#include "Metrics.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+namespace mobilesacn {
+
+/**
+ * Trim whitespace from both ends of @p str.
+ * @internal
+ */
+static std::string_view trim(std::string_view str)
+{
+    const auto first = str.find_first_not_of(" \t");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    const auto last = str.find_last_not_of(" \t");
+    return str.substr(first, last - first + 1);
+}
+
+/**
+ * Check if the comma-separated header value @p value contains @p token, ignoring case.
+ * @internal
+ */
+static bool headerHasToken(std::string_view value, std::string_view token)
+{
+    while (!value.empty()) {
+        const auto commaPos = value.find(',');
+        const auto item = trim(value.substr(0, commaPos));
+        if (std::ranges::equal(item, token, [](char lhs, char rhs) {
+                return std::tolower(static_cast<unsigned char>(lhs))
+                       == std::tolower(static_cast<unsigned char>(rhs));
+            })) {
+            return true;
+        }
+        if (commaPos == std::string_view::npos) {
+            break;
+        }
+        value.remove_prefix(commaPos + 1);
+    }
+    return false;
+}
+
+/**
+ * @internal
+ */
+static std::string_view reasonPhrase(int status)
+{
+    switch (status) {
+    case 200:
+        return "OK";
+    case 204:
+        return "No Content";
+    case 302:
+        return "Found";
+    case 304:
+        return "Not Modified";
+    case 400:
+        return "Bad Request";
+    case 404:
+        return "Not Found";
+    case 405:
+        return "Method Not Allowed";
+    case 413:
+        return "Content Too Large";
+    case 415:
+        return "Unsupported Media Type";
+    case 431:
+        return "Request Header Fields Too Large";
+    case 500:
+        return "Internal Server Error";
+    case 501:
+        return "Not Implemented";
+    default:
+        return "Unknown";
+    }
+}
+
+std::string_view HttpRequest::header(std::string_view name) const
+{
+    const auto it = headers.find(name);
+    if (it == headers.cend()) {
+        return {};
+    }
+    return it->second;
+}
+
+void HttpResponse::setHeader(std::string name, std::string value)
+{
+    headers.emplace_back(std::move(name), std::move(value));
+}
+
+void HttpResponse::setContent(QByteArray content, std::string contentType)
+{
+    body = std::move(content);
+    setHeader("Content-Type", std::move(contentType));
+}
+
+void HttpResponse::setRedirect(const std::string &location)
+{
+    status = 302;
+    setHeader("Location", location);
+}
+
+HttpConnection::HttpConnection(
+    QTcpSocket *socket, RequestHandler onRequest, UpgradeFilter acceptUpgrade, QObject *parent) :
+    QObject(parent),
+    socket_(socket),
+    onRequest_(std::move(onRequest)),
+    acceptUpgrade_(std::move(acceptUpgrade))
+{
+    Metrics::get().httpConnections.add();
+    socket_->setParent(this);
+    connect(socket_, &QTcpSocket::readyRead, this, &HttpConnection::onReadyRead);
+    connect(socket_, &QTcpSocket::disconnected, this, &HttpConnection::deleteLater);
+
+    idleTimer_.setSingleShot(true);
+    idleTimer_.setInterval(kKeepAliveTimeout);
+    connect(&idleTimer_, &QTimer::timeout, socket_, &QTcpSocket::disconnectFromHost);
+    idleTimer_.start();
+
+    // Data may have arrived before the connection was set up.
+    if (socket_->bytesAvailable() > 0) {
+        QMetaObject::invokeMethod(this, &HttpConnection::onReadyRead, Qt::QueuedConnection);
+    }
+}
+
+HttpConnection::~HttpConnection()
+{
+    Metrics::get().httpConnections.sub();
+}
+
+void HttpConnection::onReadyRead()
+{
+    if (socket_ == nullptr) {
+        return;
+    }
+    idleTimer_.start();
+
+    // Handle every complete request in the buffer, as clients may pipeline requests.
+    while (keepAlive_ && (pending_ || socket_->bytesAvailable() > 0)) {
+        if (!pending_) {
+            // Peek so an upgrade request is left intact for the websocket server.
+            const auto available = socket_->peek(kMaxHeaderSize);
+            const auto headEnd = available.indexOf("\r\n\r\n");
+            if (headEnd < 0) {
+                if (available.size() >= kMaxHeaderSize) {
+                    writeError(431);
+                }
+                return;
+            }
+            auto req = parseHead(QByteArrayView(available).first(headEnd));
+            if (!req) {
+                writeError(400);
+                return;
+            }
+
+            if (req->method == "GET" && headerHasToken(req->header("upgrade"), "websocket")
+                && acceptUpgrade_(*req)) {
+                idleTimer_.stop();
+                socket_->disconnect(this);
+                socket_->setParent(nullptr);
+                Q_EMIT(upgradeRequested(std::exchange(socket_, nullptr)));
+                deleteLater();
+                return;
+            }
+
+            socket_->skip(headEnd + 4);
+            if (!req->header("transfer-encoding").empty()) {
+                // Nothing this server accepts is large enough to need chunked uploads.
+                writeError(501);
+                return;
+            }
+            const auto contentLength = req->header("content-length");
+            std::size_t bodySize = 0;
+            if (!contentLength.empty()) {
+                const auto [ptr, ec] = std::from_chars(
+                    contentLength.data(), contentLength.data() + contentLength.size(), bodySize);
+                if (ec != std::errc() || ptr != contentLength.data() + contentLength.size()) {
+                    writeError(400);
+                    return;
+                }
+            }
+            if (bodySize > kMaxBodySize) {
+                writeError(413);
+                return;
+            }
+            pending_ = std::move(req);
+            pendingBodySize_ = bodySize;
+        }
+
+        if (static_cast<std::size_t>(socket_->bytesAvailable()) < pendingBodySize_) {
+            // Wait for the rest of the body.
+            return;
+        }
+        auto req = std::move(pending_);
+        req->body = socket_->read(static_cast<qint64>(pendingBodySize_));
+        pendingBodySize_ = 0;
+        handleRequest(*req);
+    }
+}
+
+std::unique_ptr<HttpRequest> HttpConnection::parseHead(QByteArrayView head) const
+{
+    const std::string_view headStr(head.data(), head.size());
+    const auto requestLineEnd = headStr.find("\r\n");
+    const auto requestLine = headStr.substr(0, requestLineEnd);
+
+    // METHOD SP request-target SP HTTP-version
+    const auto methodEnd = requestLine.find(' ');
+    const auto targetEnd = requestLine.rfind(' ');
+    if (methodEnd == std::string_view::npos || targetEnd == methodEnd) {
+        return nullptr;
+    }
+    auto req = std::make_unique<HttpRequest>();
+    req->method = requestLine.substr(0, methodEnd);
+    req->version = requestLine.substr(targetEnd + 1);
+    if (!req->version.starts_with("HTTP/1.")) {
+        return nullptr;
+    }
+    const auto target = requestLine.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+    if (!target.starts_with('/')) {
+        return nullptr;
+    }
+    const auto queryPos = target.find('?');
+    const auto rawPath = target.substr(0, queryPos);
+    req->path = QByteArray::fromPercentEncoding(QByteArray(rawPath.data(), rawPath.size()))
+                    .toStdString();
+    if (queryPos != std::string_view::npos) {
+        req->query = target.substr(queryPos + 1);
+    }
+    req->remoteAddr = socket_->peerAddress();
+
+    auto headers = requestLineEnd == std::string_view::npos
+                       ? std::string_view()
+                       : headStr.substr(requestLineEnd + 2);
+    while (!headers.empty()) {
+        const auto lineEnd = headers.find("\r\n");
+        const auto line = headers.substr(0, lineEnd);
+        headers = lineEnd == std::string_view::npos ? std::string_view()
+                                                    : headers.substr(lineEnd + 2);
+        const auto colonPos = line.find(':');
+        if (colonPos == std::string_view::npos || colonPos == 0) {
+            return nullptr;
+        }
+        std::string name(line.substr(0, colonPos));
+        std::ranges::transform(name, name.begin(), [](unsigned char c) {
+            return std::tolower(c);
+        });
+        const auto value = trim(line.substr(colonPos + 1));
+        auto [it, inserted] = req->headers.try_emplace(std::move(name), value);
+        if (!inserted) {
+            // Repeated headers are equivalent to a single comma-separated list.
+            it->second.append(", ").append(value);
+        }
+    }
+
+    return req;
+}
+
+void HttpConnection::handleRequest(const HttpRequest &req)
+{
+    MSACN_TRACE_SPAN("HTTP request", req.path);
+    // HTTP/1.1 connections stay open unless asked otherwise, HTTP/1.0 is the other way around.
+    const auto connection = req.header("connection");
+    keepAlive_ = req.version == "HTTP/1.0" ? headerHasToken(connection, "keep-alive")
+                                           : !headerHasToken(connection, "close");
+
+    HttpResponse res;
+    try {
+        onRequest_(req, res);
+    } catch (const std::exception &e) {
+        SPDLOG_ERROR("Error handling {} {}: {}", req.method, req.path, e.what());
+        res = HttpResponse{.status = 500};
+    }
+    writeResponse(req, res);
+
+    if (!keepAlive_) {
+        socket_->disconnectFromHost();
+    }
+}
+
+void HttpConnection::writeResponse(const HttpRequest &req, const HttpResponse &res)
+{
+    auto out = fmt::memory_buffer();
+    auto outIt = std::back_inserter(out);
+    fmt::format_to(outIt, "HTTP/1.1 {} {}\r\n", res.status, reasonPhrase(res.status));
+    for (const auto &[name, value] : res.headers) {
+        fmt::format_to(outIt, "{}: {}\r\n", name, value);
+    }
+    const bool hasBody = res.status >= 200 && res.status != 204 && res.status != 304;
+    if (hasBody) {
+        fmt::format_to(outIt, "Content-Length: {}\r\n", res.body.size());
+    }
+    fmt::format_to(outIt, "Connection: {}\r\n\r\n", keepAlive_ ? "keep-alive" : "close");
+    socket_->write(out.data(), static_cast<qint64>(out.size()));
+    if (hasBody && req.method != "HEAD") {
+        socket_->write(res.body);
+    }
+
+    SPDLOG_DEBUG(
+        "{time:%Y-%m-%d %H:%M:%S} {addr} \"{method} {path}\" {status} {size}B",
+        fmt::arg("time", std::chrono::system_clock::now()),
+        fmt::arg("addr", req.remoteAddr.toString().toStdString()),
+        fmt::arg("method", req.method),
+        fmt::arg("path", req.path),
+        fmt::arg("status", res.status),
+        fmt::arg("size", res.body.size()));
+}
+
+void HttpConnection::writeError(int status)
+{
+    SPDLOG_DEBUG(
+        "Rejecting request from {}: {} {}",
+        socket_->peerAddress().toString().toStdString(),
+        status,
+        reasonPhrase(status));
+    keepAlive_ = false;
+    const auto response = fmt::format(
+        "HTTP/1.1 {} {}\r\nContent-Length: 0\r\nConnection: close\r\n\r\n",
+        status,
+        reasonPhrase(status));
+    socket_->write(response.data(), static_cast<qint64>(response.size()));
+    socket_->disconnectFromHost();
+}
+
+} // namespace mobilesacn
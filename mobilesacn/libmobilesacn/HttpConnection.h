@@ -0,0 +1,126 @@
+/**
+ * @file HttpConnection.h
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#ifndef MOBILESACN_LIBMOBILESACN_HTTPCONNECTION_H
+#define MOBILESACN_LIBMOBILESACN_HTTPCONNECTION_H
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <QByteArray>
+#include <QHostAddress>
+#include <QTcpSocket>
+#include <QTimer>
+
+namespace mobilesacn {
+
+struct HttpRequest
+{
+    std::string method;
+    std::string version;
+    /** Percent-decoded path, without the query string. */
+    std::string path;
+    std::string query;
+    /** Header names are stored lowercase. */
+    std::map<std::string, std::string, std::less<>> headers;
+    QByteArray body;
+    QHostAddress remoteAddr;
+
+    /**
+     * Get the value of header @p name (lowercase), or an empty string if it is not present.
+     */
+    [[nodiscard]] std::string_view header(std::string_view name) const;
+};
+
+struct HttpResponse
+{
+    int status = 200;
+    std::vector<std::pair<std::string, std::string>> headers;
+    /**
+     * May be created with QByteArray::fromRawData(). It is copied into the socket's write buffer as
+     * soon as the request handler returns.
+     */
+    QByteArray body;
+
+    void setHeader(std::string name, std::string value);
+    void setContent(QByteArray content, std::string contentType);
+    void setRedirect(const std::string &location);
+};
+
+/**
+ * A single HTTP/1.1 client connection.
+ *
+ * Requests are read and answered on the thread the socket lives on. Websocket upgrade requests are
+ * passed on without reading anything from the socket, so the websocket server can do its own
+ * handshake.
+ */
+class HttpConnection : public QObject
+{
+    Q_OBJECT
+
+public:
+    using RequestHandler = std::function<void(const HttpRequest &req, HttpResponse &res)>;
+    /** Check if an upgrade request for this path should be accepted. */
+    using UpgradeFilter = std::function<bool(const HttpRequest &req)>;
+
+    /**
+     * @param socket Connected socket. The connection takes ownership.
+     * @param onRequest Called for every complete request.
+     * @param acceptUpgrade Called for every websocket upgrade request.
+     * @param parent
+     */
+    explicit HttpConnection(
+        QTcpSocket *socket,
+        RequestHandler onRequest,
+        UpgradeFilter acceptUpgrade,
+        QObject *parent = nullptr);
+    ~HttpConnection() override;
+
+Q_SIGNALS:
+    /**
+     * The client asked to upgrade to a websocket.
+     *
+     * @param socket The socket, with the handshake still unread. Ownership passes to the receiver
+     * and this connection deletes itself.
+     */
+    void upgradeRequested(QTcpSocket *socket);
+
+private:
+    static constexpr auto kMaxHeaderSize = 16 * 1024;
+    static constexpr auto kMaxBodySize = 1024 * 1024;
+    static constexpr auto kKeepAliveTimeout = std::chrono::seconds(5);
+
+    QTcpSocket *socket_;
+    RequestHandler onRequest_;
+    UpgradeFilter acceptUpgrade_;
+    QTimer idleTimer_;
+    /** Request whose headers have been read, waiting for its body. */
+    std::unique_ptr<HttpRequest> pending_;
+    std::size_t pendingBodySize_ = 0;
+    bool keepAlive_ = true;
+
+    void onReadyRead();
+    /**
+     * Parse the request line and headers in @p head.
+     *
+     * @return The request, or nullptr if it is malformed.
+     */
+    std::unique_ptr<HttpRequest> parseHead(QByteArrayView head) const;
+    void handleRequest(const HttpRequest &req);
+    void writeResponse(const HttpRequest &req, const HttpResponse &res);
+    void writeError(int status);
+};
+
+} // namespace mobilesacn
+
+#endif //MOBILESACN_LIBMOBILESACN_HTTPCONNECTION_H
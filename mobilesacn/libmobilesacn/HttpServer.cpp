@@ -9,228 +9,345 @@
 #include "HttpServer.h"
 #include "ClientSettings.h"
 #include "HandlerFactory.h"
+#include "Latency.h"
+#include "Metrics.h"
+#include "Trace.h"
 #include "mobilesacn_config.h"
-#include <fmt/chrono.h>
+#include <algorithm>
 #include <fmt/format.h>
 #include <spdlog/spdlog.h>
 #include <QAbstractSocket>
 #include <QCoreApplication>
-#include <QDir>
+#include <QJsonDocument>
 #include <QJsonObject>
 #include <QMetaEnum>
-#include <QMimeDatabase>
-#include <QResource>
+#include <QTcpServer>
+#include <QWebSocketServer>
 
 namespace mobilesacn {
 
 HttpServer::HttpServer(Options options, QObject *parent) :
-    QObject(parent), options_(std::move(options)), wsServer_({}, QWebSocketServer::NonSecureMode)
-{
-    connect(&wsServer_, &QWebSocketServer::newConnection, this, &HttpServer::onWsNewConnection);
-    connect(&wsServer_, &QWebSocketServer::acceptError, this, &HttpServer::onWsAcceptError);
-    connect(&wsServer_, &QWebSocketServer::serverError, this, &HttpServer::onWsServerError);
-}
+    QObject(parent),
+    options_(std::move(options)),
+    workerPool_(new HandlerWorkerPool(options_.worker_threads, this)),
+    clientSettings_(new ClientSettingsStore(this))
+{}
 
 HttpServer::~HttpServer()
 {
     stop();
 }
 
-void HttpServer::run()
+bool HttpServer::run()
 {
-    server_.bind_to_port(options_.backend_address, kHttpPort);
-    if (!wsServer_.listen(QHostAddress(QString::fromStdString(options_.backend_address)))) {
-        SPDLOG_ERROR("Failed to start WebSocket server: {}", wsServer_.errorString().toStdString());
-        return;
+    controller_ = new HttpServerController(
+        QHostAddress(QString::fromStdString(options_.backend_address)),
+        options_.port,
+        workerPool_,
+        [this](BaseHandler *handler, QWebSocket *ws) {
+            // Runs on the worker thread, so these are delivered to the GUI thread as queued
+            // signals.
+            connect(handler, &BaseHandler::stopped, this, &HttpServer::handlerStopped);
+            Q_EMIT(handlerStarted(handler->getDisplayName(), ws->peerAddress()));
+        },
+        clientSettings_,
+        this);
+    controller_->start();
+    if (!controller_->waitUntilReady()) {
+        controller_->wait();
+        delete controller_;
+        controller_ = nullptr;
+        return false;
     }
 
-    auto controller = new HttpServerController(&server_, &wsServer_, this);
-    connect(
-        controller, &HttpServerController::finished, controller, &HttpServerController::deleteLater);
-    controller->start();
-    server_.wait_until_ready();
-
     SPDLOG_INFO("Server listening on {}", getUrl());
+    return true;
 }
 
 void HttpServer::stop()
 {
-    if (server_.is_running()) {
+    if (controller_) {
         SPDLOG_INFO("Stopping HTTP Server");
-        server_.stop();
-        // Wait for stop.
-        while (server_.is_running()) {
-            QThread::msleep(100);
-        }
+        controller_->quit();
+        controller_->wait();
+        delete controller_;
+        controller_ = nullptr;
+        workerPool_->stop();
+        clientSettings_->stop();
         SPDLOG_INFO("HTTP Server stopped");
     }
-
-    if (wsServer_.isListening()) {
-        SPDLOG_INFO("Stopping WS Server");
-        wsServer_.close();
-        SPDLOG_INFO("WS Server stopped");
-    }
 }
 
 std::string HttpServer::getUrl()
 {
-    return fmt::format("http://{}:{}", options_.backend_address, kHttpPort);
+    return fmt::format("http://{}:{}", options_.backend_address, options_.port);
 }
 
-HttpQtTaskQueue::HttpQtTaskQueue(QObject *parent) :
-    QObject(parent), threadPool_(new QThreadPool(this))
-{
-    threadPool_->setMaxThreadCount(CPPHTTPLIB_THREAD_POOL_MAX_COUNT);
-}
+const HttpServerController::Route HttpServerController::kRoutes[] = {
+    // Settings
+    {"GET", "/clientsettings", &HttpServerController::getClientSettings},
+    {"PUT", "/clientsettings", &HttpServerController::putClientSettings},
+    // Diagnostics
+    {"GET", "/latency", &HttpServerController::getLatency, true},
+    {"GET", "/metrics", &HttpServerController::getMetrics, true},
+    {"GET", "/trace", &HttpServerController::getTrace, true},
+    {"PUT", "/trace", &HttpServerController::putTrace, true},
+};
 
-bool HttpQtTaskQueue::enqueue(std::function<void()> fn)
+HttpServerController::HttpServerController(
+    QHostAddress address,
+    uint16_t port,
+    HandlerWorkerPool *workerPool,
+    HandlerWorkerPool::CreatedCallback onHandlerCreated,
+    ClientSettingsStore *clientSettings,
+    QObject *parent) :
+    QThread(parent),
+    address_(std::move(address)),
+    port_(port),
+    workerPool_(workerPool),
+    onHandlerCreated_(std::move(onHandlerCreated)),
+    clientSettings_(clientSettings)
 {
-    threadPool_->start(std::move(fn));
-    return true;
+    setObjectName(QStringLiteral("HttpServer"));
 }
 
-void HttpQtTaskQueue::shutdown()
+bool HttpServerController::waitUntilReady()
 {
-    threadPool_->clear();
-    threadPool_->waitForDone();
+    return ready_.get_future().get();
 }
 
-HttpServerController::HttpServerController(
-    httplib::Server *server, QWebSocketServer *wsServer, QObject *parent) :
-    QThread(parent), server_(server), wsServer_(wsServer)
-{}
-
 void HttpServerController::run()
 {
-    // Threading.
-    server_->new_task_queue = []() { return new HttpQtTaskQueue; };
-
-    // Logging.
-    server_->set_logger([](const httplib::Request &req, const httplib::Response &res) {
-        SPDLOG_DEBUG(
-            "{time:%Y-%m-%d %H:%M:%S} {addr} \"{method} {path}\" {status} {size}B",
-            fmt::arg("time", std::chrono::system_clock::now()),
-            fmt::arg("addr", req.remote_addr),
-            fmt::arg("method", req.method),
-            fmt::arg("path", req.path),
-            fmt::arg("status", res.status),
-            fmt::arg("size", res.body.size()));
-    });
+    // Everything below lives on this thread.
+    QTcpServer tcpServer;
+    QWebSocketServer wsServer(QString(), QWebSocketServer::NonSecureMode);
 
-    // CORS
-    server_->set_post_routing_handler([](const httplib::Request &req, httplib::Response &res) {
-        res.set_header("Access-Control-Allow-Origin", "*");
-        res.set_header("Access-Control-Allow-Methods", "GET");
-        res.set_header("Access-Control-Allow-Headers", "Content-Type");
+    connect(&tcpServer, &QTcpServer::newConnection, &tcpServer, [this, &tcpServer, &wsServer]() {
+        while (auto socket = tcpServer.nextPendingConnection()) {
+            auto connection = new HttpConnection(
+                socket,
+                [this](const HttpRequest &req, HttpResponse &res) { handleRequest(req, res); },
+                [](const HttpRequest &req) {
+                    return hasWebHandler(QString::fromStdString(req.path));
+                },
+                &tcpServer);
+            connect(
+                connection,
+                &HttpConnection::upgradeRequested,
+                &wsServer,
+                [&wsServer](QTcpSocket *upgradeSocket) {
+                    // The websocket server reads the handshake itself.
+                    wsServer.handleConnection(upgradeSocket);
+                });
+        }
     });
-
-    // Settings
-    server_->Get("/clientsettings", [this](const httplib::Request &req, httplib::Response &res) {
-        res.set_header("Cache-Control", "no-store");
-        ClientSettings settings;
-        auto json = settings.toJson();
-        json["wsRoot"] = wsServer_->serverUrl().toString();
-        res.set_content(
-            QJsonDocument(json).toJson(QJsonDocument::Compact).toStdString(), "application/json");
+    connect(&tcpServer, &QTcpServer::acceptError, [](QAbstractSocket::SocketError socketError) {
+        const auto errEnum = QMetaEnum::fromType<QAbstractSocket::SocketError>();
+        SPDLOG_WARN("Error accepting new connection: {}", errEnum.valueToKey(socketError));
     });
-    server_->Put("/clientsettings", [](const httplib::Request &req, httplib::Response &res) {
-        if (req.get_header_value("Content-Type").starts_with("application/json")) {
-            try {
-                QJsonParseError err;
-                const QByteArray data(req.body.data(), req.body.size());
-                const auto json = QJsonDocument::fromJson(data, &err);
-                if (json.isNull()) {
-                    res.status = httplib::StatusCode::BadRequest_400;
-                    res.set_content("Malformed request body", "text/plain");
-                    return;
-                }
-                ClientSettings settings(json);
-                settings.save();
-                res.set_content("Settings saved", "text/plain");
-            } catch (const std::exception &e) {
-                res.status = httplib::StatusCode::BadRequest_400;
-                res.set_content(e.what(), "text/plain");
-            }
-        } else {
-            res.status = httplib::StatusCode::UnsupportedMediaType_415;
-            res.set_content("Unsupported media type", "text/plain");
+
+    connect(&wsServer, &QWebSocketServer::newConnection, &wsServer, [this, &wsServer]() {
+        while (auto ws = wsServer.nextPendingConnection()) {
+            workerPool_->dispatch(ws, onHandlerCreated_);
         }
     });
+    connect(&wsServer, &QWebSocketServer::serverError, [&wsServer](QWebSocketProtocol::CloseCode) {
+        SPDLOG_WARN("Websocket server error: {}", wsServer.errorString().toStdString());
+    });
 
-    // Catch-all
-    server_->Get(R"(^/(.*)$)", &HttpServerController::serveStaticFile);
+    if (!tcpServer.listen(address_, port_)) {
+        SPDLOG_ERROR("Failed to start HTTP server: {}", tcpServer.errorString().toStdString());
+        ready_.set_value(false);
+        return;
+    }
+    ready_.set_value(true);
+
+    // Static files. Loaded after listening so startup isn't held up; early connections wait in the
+    // listen backlog until the event loop starts.
+    const auto webRoot = std::filesystem::path(
+                             QCoreApplication::applicationDirPath().toStdString())
+                         / ".." / config::kWebPath;
+#ifdef EMBED_WEBUI
+    // The user manual is built separately, so it is still read from disk if installed.
+    staticFiles_ = StaticFileCache::load(webRoot, embeddedWebAssets());
+#else
+    staticFiles_ = StaticFileCache::load(webRoot);
+#endif
 
-    server_->listen_after_bind();
+    exec();
 }
 
-void HttpServerController::serveStaticFile(const httplib::Request &req, httplib::Response &res)
+void HttpServerController::handleRequest(const HttpRequest &req, HttpResponse &res) const
 {
-    // Remove directory traversal
-    std::filesystem::path reqFilePath(req.matches[1].str());
-    reqFilePath = [&reqFilePath]() {
-        std::filesystem::path sanitized;
-        for (const auto &part : reqFilePath) {
-            if (part != "..") {
-                sanitized /= part;
-            }
-        }
-        return sanitized;
-    }();
-
-    // Static files
-    const auto webRoot = std::filesystem::path(qApp->applicationDirPath().toStdString()) / ".."
-                         / config::kWebPath;
-    auto staticFilePath = webRoot / reqFilePath;
-    if (!reqFilePath.empty() && std::filesystem::is_directory(staticFilePath)
-        && std::filesystem::is_regular_file(staticFilePath / "index.html")) {
-        // Redirect to the index for real directories.
-        res.set_redirect((reqFilePath / "index.html").string());
+    const auto diagnostic = std::ranges::any_of(
+        kRoutes, [&req](const Route &route) { return route.diagnostic && route.path == req.path; });
+
+    // CORS
+    if (!diagnostic) {
+        res.setHeader("Access-Control-Allow-Origin", "*");
+        res.setHeader("Access-Control-Allow-Methods", "GET");
+        res.setHeader("Access-Control-Allow-Headers", "Content-Type");
+    }
+    if (req.method == "OPTIONS") {
+        res.status = 204;
         return;
     }
 
-    // Match what would otherwise be a request for a directory entry.
-    if (reqFilePath.empty() || !std::filesystem::path(reqFilePath).has_extension()) {
-        // Let client-side routing work, so serve index.html.
-        staticFilePath = webRoot / "index.html";
+    // HEAD is answered like GET, without the body.
+    const std::string_view method = req.method == "HEAD" ? "GET" : req.method;
+    for (const auto &route : kRoutes) {
+        if (route.method == method && route.path == req.path) {
+            (this->*route.handler)(req, res);
+            return;
+        }
     }
 
-    if (std::filesystem::is_regular_file(staticFilePath)) {
-#ifdef NDEBUG
-        // Cache in production builds.
-        res.set_header("Cache-Control", "max-age=3600");
-#endif
-        res.set_file_content(staticFilePath.string());
-        return;
+    // Catch-all
+    if (method == "GET") {
+        serveStaticFile(req, res);
+    } else {
+        res.status = 404;
     }
-
-    // File not found.
-    res.status = httplib::StatusCode::NotFound_404;
 }
 
-void HttpServer::onWsNewConnection()
+void HttpServerController::getClientSettings(const HttpRequest &req, HttpResponse &res) const
 {
-    auto ws = wsServer_.nextPendingConnection();
-    auto handler = createWebHandler(ws, this);
-    const auto path = ws->requestUrl().path().toStdString();
-    if (!handler) {
-        SPDLOG_WARN("Unsupported websocket path: {}", ws->requestUrl().path().toStdString());
-        ws->close();
-        ws->deleteLater();
+    const auto snapshot = clientSettings_->snapshot();
+    res.setHeader("Cache-Control", "no-cache");
+    res.setHeader("ETag", snapshot->etag);
+    if (StaticFileCache::etagMatches(req.header("if-none-match"), snapshot->etag)) {
+        res.status = 304;
         return;
     }
-    connect(handler, &BaseHandler::stopped, this, &HttpServer::handlerStopped);
-    Q_EMIT(handlerStarted(handler->getDisplayName(), ws->peerAddress()));
+    res.setContent(snapshot->json, "application/json");
+}
+
+void HttpServerController::putClientSettings(const HttpRequest &req, HttpResponse &res) const
+{
+    if (req.header("content-type").starts_with("application/json")) {
+        try {
+            QJsonParseError err;
+            const auto json = QJsonDocument::fromJson(req.body, &err);
+            if (json.isNull()) {
+                res.status = 400;
+                res.setContent("Malformed request body", "text/plain");
+                return;
+            }
+            // Saved in the background.
+            clientSettings_->update(ClientSettings(json));
+            res.setContent("Settings saved", "text/plain");
+        } catch (const std::exception &e) {
+            res.status = 400;
+            res.setContent(e.what(), "text/plain");
+        }
+    } else {
+        res.status = 415;
+        res.setContent("Unsupported media type", "text/plain");
+    }
+}
+
+void HttpServerController::getLatency(const HttpRequest &req, HttpResponse &res) const
+{
+    res.setHeader("Cache-Control", "no-store");
+    const auto json = LatencyTracker::get().toJson();
+    res.setContent(QJsonDocument(json).toJson(QJsonDocument::Compact), "application/json");
 }
 
-void HttpServer::onWsAcceptError(QAbstractSocket::SocketError socketError)
+void HttpServerController::getMetrics(const HttpRequest &req, HttpResponse &res) const
 {
-    const auto errEnum = QMetaEnum::fromType<QAbstractSocket::SocketError>();
-    SPDLOG_WARN("Error accepting new Websocket connection: {}", errEnum.valueToKey(socketError));
+    res.setHeader("Cache-Control", "no-store");
+    res.setContent(
+        QByteArray::fromStdString(Metrics::get().toPrometheus()), "text/plain; version=0.0.4");
+}
+
+void HttpServerController::getTrace(const HttpRequest &req, HttpResponse &res) const
+{
+    res.setHeader("Cache-Control", "no-store");
+    res.setHeader("Content-Disposition", R"(attachment; filename="mobilesacn-trace.json")");
+    res.setContent(QByteArray::fromStdString(Tracer::get().toChromeJson()), "application/json");
+}
+
+void HttpServerController::putTrace(const HttpRequest &req, HttpResponse &res) const
+{
+    // Tracing slows every frame down, so only allow it to be turned on from this machine.
+    if (!req.remoteAddr.isLoopback()) {
+        res.status = 403;
+        res.setContent("Tracing can only be changed from the server itself", "text/plain");
+        return;
+    }
+    if (!req.header("content-type").starts_with("application/json")) {
+        res.status = 415;
+        res.setContent("Unsupported media type", "text/plain");
+        return;
+    }
+    const auto json = QJsonDocument::fromJson(req.body);
+    if (!json.isObject()) {
+        res.status = 400;
+        res.setContent("Malformed request body", "text/plain");
+        return;
+    }
+    // {"enabled": bool, "clear": bool}; either may be omitted.
+    const auto obj = json.object();
+    if (obj.value(QLatin1String("clear")).toBool()) {
+        Tracer::get().clear();
+    }
+    if (const auto enabled = obj.value(QLatin1String("enabled")); enabled.isBool()) {
+        Tracer::get().setEnabled(enabled.toBool());
+        SPDLOG_INFO("Tracing {}", enabled.toBool() ? "enabled" : "disabled");
+    }
+    res.setContent(Tracer::get().enabled() ? "Tracing enabled" : "Tracing disabled", "text/plain");
 }
 
-void HttpServer::onWsServerError(QWebSocketProtocol::CloseCode closeCode)
+void HttpServerController::serveStaticFile(const HttpRequest &req, HttpResponse &res) const
 {
-    SPDLOG_WARN("Websocket server error: {}", wsServer_.errorString().toStdString());
+    // Only files loaded into the cache can be served, so there is no way to escape the web root.
+    auto reqFilePath = req.path.substr(1);
+    const auto dirIndexPath = reqFilePath.empty() || reqFilePath.ends_with('/')
+                                  ? reqFilePath + "index.html"
+                                  : reqFilePath + "/index.html";
+    if (!reqFilePath.empty() && staticFiles_->find(dirIndexPath) != nullptr) {
+        // Redirect to the index for real directories.
+        res.setRedirect("/" + dirIndexPath);
+        return;
+    }
+
+    // Match what would otherwise be a request for a directory entry.
+    const auto fileName = reqFilePath.substr(reqFilePath.rfind('/') + 1);
+    if (fileName.find('.') == std::string::npos) {
+        // Let client-side routing work, so serve index.html.
+        reqFilePath = "index.html";
+    }
+
+    const auto entry = staticFiles_->find(reqFilePath);
+    if (entry == nullptr) {
+        // File not found.
+        res.status = 404;
+        return;
+    }
+
+    const auto &variant = entry->negotiate(req.header("accept-encoding"));
+    res.setHeader("ETag", variant.etag);
+    res.setHeader("Vary", "Accept-Encoding");
+#ifdef NDEBUG
+    // Hashed bundles never change, everything else is cheap to revalidate.
+    res.setHeader(
+        "Cache-Control", entry->immutable ? "public, max-age=31536000, immutable" : "no-cache");
+#else
+    res.setHeader("Cache-Control", "no-cache");
+#endif
+    if (StaticFileCache::etagMatches(req.header("if-none-match"), variant.etag)) {
+        res.status = 304;
+        return;
+    }
+
+    if (variant.encoding != StaticFileCache::Encoding::Identity) {
+        res.setHeader(
+            "Content-Encoding", std::string(StaticFileCache::encodingName(variant.encoding)));
+    }
+    // Serve straight from the cache instead of copying into the response body.
+    res.setContent(
+        QByteArray::fromRawData(variant.body.data(), static_cast<qsizetype>(variant.body.size())),
+        entry->contentType);
 }
 
 } // namespace mobilesacn
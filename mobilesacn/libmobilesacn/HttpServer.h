@@ -9,36 +9,24 @@
 #ifndef MOBILE_SACN_INCLUDE_LIBMOBILESACN_HTTPSERVER_H_
 #define MOBILE_SACN_INCLUDE_LIBMOBILESACN_HTTPSERVER_H_
 
+#include "ClientSettings.h"
+#include "HandlerWorkerPool.h"
+#include "HttpConnection.h"
+#include "StaticFileCache.h"
 #include <etcpal/cpp/netint.h>
 #include <filesystem>
-#include <httplib.h>
+#include <future>
 #include <string>
 #include <QThread>
-#include <QThreadPool>
-#include <QWebSocketServer>
 
 namespace mobilesacn {
 
-/**
- * httplib::TaskQueue that uses a QThreadPool.
- *
- * This keeps all threads managed by a QThread.
- */
-class HttpQtTaskQueue : public QObject, public httplib::TaskQueue
-{
-    Q_OBJECT
-
-public:
-    explicit HttpQtTaskQueue(QObject *parent = nullptr);
-    bool enqueue(std::function<void()> fn) override;
-    void shutdown() override;
-
-private:
-    QThreadPool *threadPool_;
-};
-
 /**
  * Run the HTTP server in its own thread.
+ *
+ * HTTP and websocket connections share a single port and a single event loop. Websocket upgrade
+ * requests are handed to a QWebSocketServer, which then passes the websocket on to the handler
+ * worker pool.
  */
 class HttpServerController : public QThread
 {
@@ -46,33 +34,75 @@ class HttpServerController : public QThread
 
 public:
     explicit HttpServerController(
-        httplib::Server *server, QWebSocketServer *wsServer, QObject *parent = nullptr);
+        QHostAddress address,
+        uint16_t port,
+        HandlerWorkerPool *workerPool,
+        HandlerWorkerPool::CreatedCallback onHandlerCreated,
+        ClientSettingsStore *clientSettings,
+        QObject *parent = nullptr);
+
+    /**
+     * Wait until the server has started listening.
+     *
+     * @return If the server is listening.
+     */
+    bool waitUntilReady();
 
 protected:
     void run() override;
 
 private:
-    httplib::Server *server_;
-    QWebSocketServer *wsServer_;
+    using RouteHandler = void (HttpServerController::*)(const HttpRequest &, HttpResponse &) const;
+    struct Route
+    {
+        std::string_view method;
+        std::string_view path;
+        RouteHandler handler;
+        /** Diagnostics are not readable from other origins. */
+        bool diagnostic = false;
+    };
+
+    QHostAddress address_;
+    uint16_t port_;
+    HandlerWorkerPool *workerPool_;
+    HandlerWorkerPool::CreatedCallback onHandlerCreated_;
+    ClientSettingsStore *clientSettings_;
+    std::promise<bool> ready_;
+    StaticFileCache::Ptr staticFiles_;
+
+    void handleRequest(const HttpRequest &req, HttpResponse &res) const;
 
     // Route handlers.
-    static void serveStaticFile(const httplib::Request &req, httplib::Response &res);
+    void getClientSettings(const HttpRequest &req, HttpResponse &res) const;
+    void putClientSettings(const HttpRequest &req, HttpResponse &res) const;
+    void getLatency(const HttpRequest &req, HttpResponse &res) const;
+    void getMetrics(const HttpRequest &req, HttpResponse &res) const;
+    void getTrace(const HttpRequest &req, HttpResponse &res) const;
+    void putTrace(const HttpRequest &req, HttpResponse &res) const;
+    void serveStaticFile(const HttpRequest &req, HttpResponse &res) const;
+
+    static const Route kRoutes[];
 };
 
 /**
  * HTTP web server.
  *
- * Handles serving the Web UI and RPC requests.
+ * Handles serving the Web UI, RPC requests, and websockets, all on one port.
  */
 class HttpServer : public QObject
 {
     Q_OBJECT
 
 public:
+    static constexpr uint16_t kDefaultPort = 5050;
+
     struct Options
     {
         std::string backend_address;
         etcpal::NetintInfo sacn_interface;
+        uint16_t port = kDefaultPort;
+        /** Number of threads running web handlers, or 0 to use one per core. */
+        unsigned int worker_threads = 0;
     };
 
     /**
@@ -86,7 +116,12 @@ public:
     explicit HttpServer(Options options, QObject *parent = nullptr);
     ~HttpServer();
 
-    void run();
+    /**
+     * Start listening.
+     *
+     * @return If the server started.
+     */
+    bool run();
     void stop();
     [[nodiscard]] std::string getUrl();
 
@@ -97,16 +132,10 @@ Q_SIGNALS:
     void handlerStopped(const QString &displayName, const QHostAddress &clientAddress);
 
 private:
-    static constexpr uint16_t kHttpPort = 5050;
-
     Options options_;
-    httplib::Server server_;
-    QWebSocketServer wsServer_;
-
-private Q_SLOTS:
-    void onWsNewConnection();
-    void onWsAcceptError(QAbstractSocket::SocketError socketError);
-    void onWsServerError(QWebSocketProtocol::CloseCode closeCode);
+    HandlerWorkerPool *workerPool_;
+    ClientSettingsStore *clientSettings_;
+    HttpServerController *controller_ = nullptr;
 };
 } // namespace mobilesacn
 
@@ -0,0 +1,164 @@
+/**
+ * @file Latency.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "Latency.h"
+#include <algorithm>
+#include <QJsonArray>
+
+namespace mobilesacn {
+
+void LatencyHistogram::record(const std::chrono::steady_clock::duration duration)
+{
+    const auto us = static_cast<uint64_t>(
+        std::max<int64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(duration).count(), 0));
+    const auto bucket = std::ranges::lower_bound(kBucketBoundsUs, us) - kBucketBoundsUs.cbegin();
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    sumUs_.fetch_add(us, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const
+{
+    Snapshot snapshot;
+    for (std::size_t ix = 0; ix < kBucketCount; ++ix) {
+        snapshot.buckets[ix] = buckets_[ix].load(std::memory_order_relaxed);
+    }
+    snapshot.count = count_.load(std::memory_order_relaxed);
+    snapshot.sumUs = sumUs_.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+uint64_t LatencyHistogram::Snapshot::percentileUs(const double pct) const
+{
+    const auto target = static_cast<uint64_t>(pct / 100.0 * static_cast<double>(count));
+    uint64_t seen = 0;
+    for (std::size_t ix = 0; ix < kBucketBoundsUs.size(); ++ix) {
+        seen += buckets[ix];
+        if (seen > target) {
+            return kBucketBoundsUs[ix];
+        }
+    }
+    // Larger than the largest bucket.
+    return kBucketBoundsUs.back();
+}
+
+QJsonObject LatencyHistogram::toJson() const
+{
+    const auto snapshot = this->snapshot();
+    QJsonObject json;
+    json["count"] = static_cast<qint64>(snapshot.count);
+    json["sumUs"] = static_cast<qint64>(snapshot.sumUs);
+    if (snapshot.count > 0) {
+        json["p50Us"] = static_cast<qint64>(snapshot.percentileUs(50));
+        json["p95Us"] = static_cast<qint64>(snapshot.percentileUs(95));
+        json["p99Us"] = static_cast<qint64>(snapshot.percentileUs(99));
+    }
+    QJsonArray buckets;
+    for (std::size_t ix = 0; ix < kBucketCount; ++ix) {
+        QJsonObject bucket;
+        if (ix < kBucketBoundsUs.size()) {
+            bucket["leUs"] = static_cast<qint64>(kBucketBoundsUs[ix]);
+        } else {
+            bucket["leUs"] = QJsonValue::Null;
+        }
+        bucket["count"] = static_cast<qint64>(snapshot.buckets[ix]);
+        buckets.append(bucket);
+    }
+    json["buckets"] = buckets;
+    return json;
+}
+
+FrameLatency::Snapshot FrameLatency::snapshot() const
+{
+    return {
+        .queue = queue.snapshot(),
+        .encode = encode.snapshot(),
+        .send = send.snapshot(),
+        .total = total.snapshot(),
+    };
+}
+
+QJsonObject FrameLatency::toJson() const
+{
+    QJsonObject json;
+    json["queue"] = queue.toJson();
+    json["encode"] = encode.toJson();
+    json["send"] = send.toJson();
+    json["total"] = total.toJson();
+    return json;
+}
+
+LatencyTracker &LatencyTracker::get()
+{
+    static LatencyTracker instance;
+
+    return instance;
+}
+
+FrameLatency &LatencyTracker::forUniverse(const uint16_t universe)
+{
+    std::scoped_lock lock(mutex_);
+    auto &latency = universes_[universe];
+    if (!latency) {
+        latency = std::make_unique<FrameLatency>();
+    }
+    return *latency;
+}
+
+std::shared_ptr<FrameLatency> LatencyTracker::registerClient(const QString &name)
+{
+    auto latency = std::make_shared<FrameLatency>();
+    std::scoped_lock lock(mutex_);
+    pruneClients();
+    clients_.push_back({name, latency});
+    return latency;
+}
+
+std::map<uint16_t, FrameLatency::Snapshot> LatencyTracker::universeSnapshots()
+{
+    std::scoped_lock lock(mutex_);
+    std::map<uint16_t, FrameLatency::Snapshot> snapshots;
+    for (const auto &[universe, latency] : universes_) {
+        snapshots.emplace(universe, latency->snapshot());
+    }
+    return snapshots;
+}
+
+QJsonObject LatencyTracker::toJson()
+{
+    std::scoped_lock lock(mutex_);
+    pruneClients();
+
+    QJsonObject universesJson;
+    for (const auto &[universe, latency] : universes_) {
+        universesJson[QString::number(universe)] = latency->toJson();
+    }
+    QJsonArray clientsJson;
+    for (const auto &client : clients_) {
+        const auto latency = client.latency.lock();
+        if (!latency) {
+            continue;
+        }
+        auto clientJson = latency->toJson();
+        clientJson["name"] = client.name;
+        clientsJson.append(clientJson);
+    }
+
+    QJsonObject json;
+    json["universes"] = universesJson;
+    json["clients"] = clientsJson;
+    return json;
+}
+
+void LatencyTracker::pruneClients()
+{
+    std::erase_if(clients_, [](const Client &client) { return client.latency.expired(); });
+}
+
+} // namespace mobilesacn
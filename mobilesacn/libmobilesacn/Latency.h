@@ -0,0 +1,166 @@
+/**
+ * @file Latency.h
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#ifndef MOBILESACN_LIBMOBILESACN_LATENCY_H
+#define MOBILESACN_LIBMOBILESACN_LATENCY_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <QJsonObject>
+#include <QString>
+
+namespace mobilesacn {
+
+/**
+ * Fixed-bucket latency histogram.
+ *
+ * Recording is lock-free so it can be done from any thread, including the sACN thread.
+ */
+class LatencyHistogram
+{
+public:
+    /** Upper bound of each bucket, in microseconds. A final bucket catches everything larger. */
+    static constexpr std::array<uint64_t, 16> kBucketBoundsUs{
+        50,
+        100,
+        250,
+        500,
+        1'000,
+        2'500,
+        5'000,
+        10'000,
+        25'000,
+        50'000,
+        100'000,
+        250'000,
+        500'000,
+        1'000'000,
+        2'500'000,
+        5'000'000,
+    };
+    static constexpr std::size_t kBucketCount = kBucketBoundsUs.size() + 1;
+
+    struct Snapshot
+    {
+        /** Count in each bucket (not cumulative). */
+        std::array<uint64_t, kBucketCount> buckets{};
+        uint64_t count = 0;
+        uint64_t sumUs = 0;
+
+        /**
+         * Estimate the @p pct percentile from the bucket bounds.
+         *
+         * @return Upper bound of the bucket containing the percentile, in microseconds.
+         */
+        [[nodiscard]] uint64_t percentileUs(double pct) const;
+    };
+
+    void record(std::chrono::steady_clock::duration duration);
+    [[nodiscard]] Snapshot snapshot() const;
+    [[nodiscard]] QJsonObject toJson() const;
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sumUs_{0};
+};
+
+/**
+ * Latency of each stage a level frame passes through on its way to a client.
+ */
+struct FrameLatency
+{
+    /** Arrival from the sACN library until a handler starts processing it. */
+    LatencyHistogram queue;
+    /** Handler processing until the message is built. */
+    LatencyHistogram encode;
+    /** Message built until it has been written to the socket. */
+    LatencyHistogram send;
+    /** Arrival from the sACN library until it has been written to the socket. */
+    LatencyHistogram total;
+
+    struct Snapshot
+    {
+        LatencyHistogram::Snapshot queue;
+        LatencyHistogram::Snapshot encode;
+        LatencyHistogram::Snapshot send;
+        LatencyHistogram::Snapshot total;
+    };
+
+    [[nodiscard]] Snapshot snapshot() const;
+    [[nodiscard]] QJsonObject toJson() const;
+};
+
+/**
+ * Timestamps collected for a single frame.
+ */
+struct FrameTiming
+{
+    /** When the frame arrived from the sACN library. */
+    std::chrono::steady_clock::time_point arrival;
+    /** When the message to the client was built. */
+    std::chrono::steady_clock::time_point encoded;
+    /** Histograms for the universe the frame belongs to. */
+    FrameLatency *universeLatency = nullptr;
+};
+
+/**
+ * Collects per-universe and per-client latency histograms.
+ */
+class LatencyTracker
+{
+public:
+    static LatencyTracker &get();
+
+    LatencyTracker(const LatencyTracker &) = delete;
+    LatencyTracker &operator=(const LatencyTracker &) = delete;
+
+    /**
+     * Get histograms for @p universe.
+     *
+     * The returned reference remains valid for the life of the program.
+     */
+    FrameLatency &forUniverse(uint16_t universe);
+
+    /**
+     * Register a new client named @p name.
+     *
+     * The client's histograms are reported for as long as the returned pointer is alive.
+     */
+    std::shared_ptr<FrameLatency> registerClient(const QString &name);
+
+    /**
+     * Get the current value of every universe's histograms.
+     */
+    [[nodiscard]] std::map<uint16_t, FrameLatency::Snapshot> universeSnapshots();
+
+    [[nodiscard]] QJsonObject toJson();
+
+private:
+    struct Client
+    {
+        QString name;
+        std::weak_ptr<FrameLatency> latency;
+    };
+
+    std::mutex mutex_;
+    std::map<uint16_t, std::unique_ptr<FrameLatency>> universes_;
+    std::vector<Client> clients_;
+
+    LatencyTracker() = default;
+    void pruneClients();
+};
+
+} // namespace mobilesacn
+
+#endif //MOBILESACN_LIBMOBILESACN_LATENCY_H
@@ -0,0 +1,270 @@
+/**
+ * @file Metrics.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "Metrics.h"
+#include "Latency.h"
+#include "logging.h"
+#include <fmt/format.h>
+#include <iterator>
+
+namespace mobilesacn {
+
+/**
+ * Escape a label value.
+ * @internal
+ */
+static std::string escapeLabel(const QString &value)
+{
+    std::string escaped;
+    for (const auto c : value.toStdString()) {
+        if (c == '\\' || c == '"') {
+            escaped.push_back('\\');
+            escaped.push_back(c);
+        } else if (c == '\n') {
+            escaped.append("\\n");
+        } else {
+            escaped.push_back(c);
+        }
+    }
+    return escaped;
+}
+
+/**
+ * Write metric metadata.
+ * @internal
+ */
+static void writeHeader(
+    std::string &out, std::string_view name, std::string_view type, std::string_view help)
+{
+    fmt::format_to(std::back_inserter(out), "# HELP {} {}\n# TYPE {} {}\n", name, help, name, type);
+}
+
+/**
+ * Write a histogram with @p labels (without braces), converting microseconds to seconds.
+ * @internal
+ */
+static void writeHistogram(
+    std::string &out,
+    std::string_view name,
+    std::string_view labels,
+    const LatencyHistogram::Snapshot &snapshot)
+{
+    auto outIt = std::back_inserter(out);
+    uint64_t cumulative = 0;
+    for (std::size_t ix = 0; ix < LatencyHistogram::kBucketBoundsUs.size(); ++ix) {
+        cumulative += snapshot.buckets[ix];
+        fmt::format_to(
+            outIt,
+            "{}_bucket{{{},le=\"{}\"}} {}\n",
+            name,
+            labels,
+            static_cast<double>(LatencyHistogram::kBucketBoundsUs[ix]) / 1e6,
+            cumulative);
+    }
+    fmt::format_to(outIt, "{}_bucket{{{},le=\"+Inf\"}} {}\n", name, labels, snapshot.count);
+    fmt::format_to(
+        outIt, "{}_sum{{{}}} {}\n", name, labels, static_cast<double>(snapshot.sumUs) / 1e6);
+    fmt::format_to(outIt, "{}_count{{{}}} {}\n", name, labels, snapshot.count);
+}
+
+Metrics &Metrics::get()
+{
+    static Metrics instance;
+
+    return instance;
+}
+
+MetricGauge &Metrics::activeHandlers(const QString &handler)
+{
+    std::scoped_lock lock(mutex_);
+    auto &gauge = activeHandlers_[handler];
+    if (!gauge) {
+        gauge = std::make_unique<MetricGauge>();
+    }
+    return *gauge;
+}
+
+UniverseMetrics &Metrics::forUniverse(const uint16_t universe)
+{
+    std::scoped_lock lock(mutex_);
+    auto &metrics = universes_[universe];
+    if (!metrics) {
+        metrics = std::make_unique<UniverseMetrics>();
+    }
+    return *metrics;
+}
+
+std::shared_ptr<ClientMetrics> Metrics::registerClient(
+    const QString &handler, const QString &address)
+{
+    auto metrics = std::make_shared<ClientMetrics>();
+    std::scoped_lock lock(mutex_);
+    pruneClients();
+    clients_.push_back({handler, address, metrics});
+    return metrics;
+}
+
+std::string Metrics::toPrometheus()
+{
+    std::scoped_lock lock(mutex_);
+    pruneClients();
+    std::string out;
+    auto outIt = std::back_inserter(out);
+
+    writeHeader(out, "mobilesacn_handlers_active", "gauge", "Connected websocket handlers.");
+    for (const auto &[handler, gauge] : activeHandlers_) {
+        fmt::format_to(
+            outIt,
+            "mobilesacn_handlers_active{{handler=\"{}\"}} {}\n",
+            escapeLabel(handler),
+            gauge->value());
+    }
+
+    writeHeader(
+        out,
+        "mobilesacn_universe_frames_total",
+        "counter",
+        "Merged frames received from the network.");
+    for (const auto &[universe, metrics] : universes_) {
+        fmt::format_to(
+            outIt,
+            "mobilesacn_universe_frames_total{{universe=\"{}\"}} {}\n",
+            universe,
+            metrics->framesReceived.value());
+    }
+    writeHeader(
+        out,
+        "mobilesacn_universe_frames_dropped_total",
+        "counter",
+        "Merged frames a handler skipped instead of sending.");
+    for (const auto &[universe, metrics] : universes_) {
+        fmt::format_to(
+            outIt,
+            "mobilesacn_universe_frames_dropped_total{{universe=\"{}\"}} {}\n",
+            universe,
+            metrics->framesDropped.value());
+    }
+    writeHeader(
+        out,
+        "mobilesacn_universe_packets_lost_total",
+        "counter",
+        "Packets skipped in sources' sequence numbers that never arrived.");
+    for (const auto &[universe, metrics] : universes_) {
+        fmt::format_to(
+            outIt,
+            "mobilesacn_universe_packets_lost_total{{universe=\"{}\"}} {}\n",
+            universe,
+            metrics->packetsLost.value());
+    }
+    writeHeader(
+        out,
+        "mobilesacn_universe_packets_duplicated_total",
+        "counter",
+        "Packets received more than once.");
+    for (const auto &[universe, metrics] : universes_) {
+        fmt::format_to(
+            outIt,
+            "mobilesacn_universe_packets_duplicated_total{{universe=\"{}\"}} {}\n",
+            universe,
+            metrics->packetsDuplicated.value());
+    }
+    writeHeader(
+        out,
+        "mobilesacn_universe_packets_out_of_order_total",
+        "counter",
+        "Packets received after newer packets from the same source.");
+    for (const auto &[universe, metrics] : universes_) {
+        fmt::format_to(
+            outIt,
+            "mobilesacn_universe_packets_out_of_order_total{{universe=\"{}\"}} {}\n",
+            universe,
+            metrics->packetsOutOfOrder.value());
+    }
+
+    writeHeader(
+        out,
+        "mobilesacn_frame_latency_seconds",
+        "histogram",
+        "Time spent in each stage between receiving a frame and writing it to a client.");
+    for (const auto &[universe, latency] : LatencyTracker::get().universeSnapshots()) {
+        const std::pair<std::string_view, const LatencyHistogram::Snapshot &> stages[]{
+            {"queue", latency.queue},
+            {"encode", latency.encode},
+            {"send", latency.send},
+            {"total", latency.total},
+        };
+        for (const auto &[stage, snapshot] : stages) {
+            writeHistogram(
+                out,
+                "mobilesacn_frame_latency_seconds",
+                fmt::format("universe=\"{}\",stage=\"{}\"", universe, stage),
+                snapshot);
+        }
+    }
+
+    writeHeader(
+        out, "mobilesacn_client_messages_sent_total", "counter", "Messages sent to each client.");
+    for (const auto &client : clients_) {
+        if (const auto metrics = client.metrics.lock()) {
+            fmt::format_to(
+                outIt,
+                "mobilesacn_client_messages_sent_total{{handler=\"{}\",client=\"{}\"}} {}\n",
+                escapeLabel(client.handler),
+                escapeLabel(client.address),
+                metrics->messagesSent.value());
+        }
+    }
+    writeHeader(out, "mobilesacn_client_bytes_sent_total", "counter", "Bytes sent to each client.");
+    for (const auto &client : clients_) {
+        if (const auto metrics = client.metrics.lock()) {
+            fmt::format_to(
+                outIt,
+                "mobilesacn_client_bytes_sent_total{{handler=\"{}\",client=\"{}\"}} {}\n",
+                escapeLabel(client.handler),
+                escapeLabel(client.address),
+                metrics->bytesSent.value());
+        }
+    }
+
+    writeHeader(
+        out,
+        "mobilesacn_log_messages_dropped_total",
+        "counter",
+        "Log messages dropped because the log queue was full.");
+    fmt::format_to(outIt, "mobilesacn_log_messages_dropped_total {}\n", droppedLogMessages());
+
+    writeHeader(out, "mobilesacn_sacn_sources", "gauge", "sACN sources on the network.");
+    fmt::format_to(outIt, "mobilesacn_sacn_sources {}\n", sacnSources.value());
+
+    writeHeader(
+        out, "mobilesacn_sacn_universes", "gauge", "sACN universes with at least one source.");
+    fmt::format_to(outIt, "mobilesacn_sacn_universes {}\n", sacnUniverses.value());
+
+    writeHeader(
+        out,
+        "mobilesacn_sacn_receivers",
+        "gauge",
+        "Running sACN merge receivers, including idle ones kept for reuse.");
+    fmt::format_to(outIt, "mobilesacn_sacn_receivers {}\n", sacnReceivers.value());
+
+    writeHeader(
+        out,
+        "mobilesacn_http_connections",
+        "gauge",
+        "Open HTTP connections, not counting websockets.");
+    fmt::format_to(outIt, "mobilesacn_http_connections {}\n", httpConnections.value());
+
+    return out;
+}
+
+void Metrics::pruneClients()
+{
+    std::erase_if(clients_, [](const Client &client) { return client.metrics.expired(); });
+}
+
+} // namespace mobilesacn
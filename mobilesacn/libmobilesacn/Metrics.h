@@ -0,0 +1,138 @@
+/**
+ * @file Metrics.h
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#ifndef MOBILESACN_LIBMOBILESACN_METRICS_H
+#define MOBILESACN_LIBMOBILESACN_METRICS_H
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <QString>
+
+namespace mobilesacn {
+
+/**
+ * Monotonically increasing count.
+ */
+class MetricCounter
+{
+public:
+    void add(uint64_t n = 1) { value_.fetch_add(n, std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> value_{0};
+};
+
+/**
+ * Value that can go up and down.
+ */
+class MetricGauge
+{
+public:
+    void add(int64_t n = 1) { value_.fetch_add(n, std::memory_order_relaxed); }
+    void sub(int64_t n = 1) { value_.fetch_sub(n, std::memory_order_relaxed); }
+    void set(int64_t n) { value_.store(n, std::memory_order_relaxed); }
+    [[nodiscard]] int64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> value_{0};
+};
+
+struct UniverseMetrics
+{
+    /** Merged frames received from the sACN library. */
+    MetricCounter framesReceived;
+    /** Frames a handler skipped instead of sending to its client. */
+    MetricCounter framesDropped;
+    /** Packets skipped over in sources' sequence numbers that never arrived. */
+    MetricCounter packetsLost;
+    /** Packets received again. */
+    MetricCounter packetsDuplicated;
+    /** Packets that arrived after newer ones. */
+    MetricCounter packetsOutOfOrder;
+};
+
+struct ClientMetrics
+{
+    MetricCounter messagesSent;
+    MetricCounter bytesSent;
+};
+
+/**
+ * Counters exported at /metrics.
+ *
+ * Updating a metric never takes a lock. Locks are only taken when a universe or client is first
+ * registered, and when the metrics are exported.
+ */
+class Metrics
+{
+public:
+    static Metrics &get();
+
+    Metrics(const Metrics &) = delete;
+    Metrics &operator=(const Metrics &) = delete;
+
+    /** Open HTTP connections, not counting those upgraded to websockets. */
+    MetricGauge httpConnections;
+    /** Sources seen by the source detector. */
+    MetricGauge sacnSources;
+    /** Universes with at least one source, as seen by the source detector. */
+    MetricGauge sacnUniverses;
+    /** Running merge receivers, including idle ones kept by the pool. */
+    MetricGauge sacnReceivers;
+
+    /**
+     * Get the number of active handlers for @p handler.
+     *
+     * The returned reference remains valid for the life of the program.
+     */
+    MetricGauge &activeHandlers(const QString &handler);
+
+    /**
+     * Get metrics for @p universe.
+     *
+     * The returned reference remains valid for the life of the program.
+     */
+    UniverseMetrics &forUniverse(uint16_t universe);
+
+    /**
+     * Register a new client at @p address, using @p handler.
+     *
+     * The client's metrics are reported for as long as the returned pointer is alive.
+     */
+    std::shared_ptr<ClientMetrics> registerClient(const QString &handler, const QString &address);
+
+    /**
+     * Export all metrics in the Prometheus text exposition format.
+     */
+    [[nodiscard]] std::string toPrometheus();
+
+private:
+    struct Client
+    {
+        QString handler;
+        QString address;
+        std::weak_ptr<ClientMetrics> metrics;
+    };
+
+    std::mutex mutex_;
+    std::map<QString, std::unique_ptr<MetricGauge>> activeHandlers_;
+    std::map<uint16_t, std::unique_ptr<UniverseMetrics>> universes_;
+    std::vector<Client> clients_;
+
+    Metrics() = default;
+    void pruneClients();
+};
+
+} // namespace mobilesacn
+
+#endif //MOBILESACN_LIBMOBILESACN_METRICS_H
@@ -112,6 +112,9 @@ public:
     MSACN_SETTING(QString, PreferredColorScheme, {})
 
     MSACN_SETTING(QString, LevelDisplayMode, QStringLiteral("percent"))
+
+    /** Serialized SnapshotStore message. */
+    MSACN_SETTING(QByteArray, Snapshots, {})
 };
 } // namespace mobilesacn
 
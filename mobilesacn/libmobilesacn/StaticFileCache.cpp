@@ -0,0 +1,236 @@
+/**
+ * @file StaticFileCache.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "StaticFileCache.h"
+#include "web_asset.h"
+#include <fmt/format.h>
+#include <fstream>
+#include <ranges>
+#include <spdlog/spdlog.h>
+
+namespace mobilesacn {
+
+/**
+ * Trim whitespace from both ends of @p str.
+ * @internal
+ */
+static std::string_view trim(std::string_view str)
+{
+    const auto first = str.find_first_not_of(" \t");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    const auto last = str.find_last_not_of(" \t");
+    return str.substr(first, last - first + 1);
+}
+
+/**
+ * View @p data as a string.
+ * @internal
+ */
+static std::string_view asStringView(std::span<const uint8_t> data)
+{
+    return {reinterpret_cast<const char *>(data.data()), data.size()};
+}
+
+StaticFileCache::Ptr StaticFileCache::load(
+    const std::filesystem::path &webRoot, std::span<const EmbeddedWebAsset> embedded)
+{
+    // Can't use make_shared with a private constructor.
+    std::shared_ptr<StaticFileCache> cache(new StaticFileCache);
+    if (!embedded.empty()) {
+        cache->addEmbedded(embedded);
+        SPDLOG_INFO("Using {} embedded Web UI files", cache->entries_.size());
+    }
+
+    std::error_code ec;
+    if (!std::filesystem::is_directory(webRoot, ec)) {
+        if (embedded.empty()) {
+            SPDLOG_ERROR("Web UI not found at {}", webRoot.string());
+        }
+        return cache;
+    }
+    cache->addFromDisk(webRoot);
+    return cache;
+}
+
+void StaticFileCache::addEmbedded(std::span<const EmbeddedWebAsset> assets)
+{
+    for (const auto &asset : assets) {
+        Entry entry;
+        entry.contentType = asset.contentType;
+        entry.immutable = asset.immutable;
+        // Point straight at the compiled-in data.
+        entry.identity = Variant{
+            .encoding = Encoding::Identity,
+            .body = asStringView(asset.identity),
+            .etag = fmt::format("\"{}\"", asset.hash),
+        };
+        if (!asset.gzip.empty()) {
+            entry.gzip = Variant{
+                .encoding = Encoding::Gzip,
+                .body = asStringView(asset.gzip),
+                .etag = fmt::format("\"{}-gz\"", asset.hash),
+            };
+        }
+        if (!asset.brotli.empty()) {
+            entry.brotli = Variant{
+                .encoding = Encoding::Brotli,
+                .body = asStringView(asset.brotli),
+                .etag = fmt::format("\"{}-br\"", asset.hash),
+            };
+        }
+        entries_.emplace(asset.path, std::move(entry));
+    }
+}
+
+void StaticFileCache::addFromDisk(const std::filesystem::path &webRoot)
+{
+    std::size_t fileCount = 0;
+    std::size_t totalSize = 0;
+    std::size_t totalCompressedSize = 0;
+    std::error_code ec;
+    for (const auto &dirEntry : std::filesystem::recursive_directory_iterator(webRoot, ec)) {
+        if (!dirEntry.is_regular_file()) {
+            continue;
+        }
+        const auto path = dirEntry.path().lexically_relative(webRoot).generic_string();
+        if (entries_.contains(path)) {
+            // Embedded files take precedence.
+            continue;
+        }
+        std::ifstream file(dirEntry.path(), std::ios::binary);
+        if (!file) {
+            SPDLOG_WARN("Could not read {}", dirEntry.path().string());
+            continue;
+        }
+        std::string data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+        Entry entry;
+        entry.contentType = webasset::contentType(dirEntry.path());
+        entry.immutable = webasset::isImmutable(path);
+        const auto hash = webasset::contentHash(data);
+        auto gzip = webasset::gzipCompress(data, 9);
+        if (webasset::worthCompressing(data, gzip)) {
+            totalCompressedSize += gzip->size();
+            entry.gzip = Variant{
+                .encoding = Encoding::Gzip,
+                .body = store(std::move(*gzip)),
+                .etag = fmt::format("\"{}-gz\"", hash),
+            };
+        }
+        // Maximum quality is too slow to do at startup.
+        auto brotli = webasset::brotliCompress(data, 9);
+        if (webasset::worthCompressing(data, brotli)) {
+            entry.brotli = Variant{
+                .encoding = Encoding::Brotli,
+                .body = store(std::move(*brotli)),
+                .etag = fmt::format("\"{}-br\"", hash),
+            };
+        }
+        totalSize += data.size();
+        if (!entry.gzip) {
+            totalCompressedSize += data.size();
+        }
+        entry.identity = Variant{
+            .encoding = Encoding::Identity,
+            .body = store(std::move(data)),
+            .etag = fmt::format("\"{}\"", hash),
+        };
+        entries_.emplace(path, std::move(entry));
+        ++fileCount;
+    }
+    if (ec) {
+        SPDLOG_ERROR("Error reading Web UI from {}: {}", webRoot.string(), ec.message());
+    }
+
+    SPDLOG_INFO(
+        "Loaded {} Web UI files from {} ({} bytes, {} bytes gzipped)",
+        fileCount,
+        webRoot.string(),
+        totalSize,
+        totalCompressedSize);
+}
+
+const StaticFileCache::Entry *StaticFileCache::find(const std::string &path) const
+{
+    const auto entry = entries_.find(path);
+    if (entry == entries_.cend()) {
+        return nullptr;
+    }
+    return &entry->second;
+}
+
+const StaticFileCache::Variant &StaticFileCache::Entry::negotiate(
+    std::string_view acceptEncoding) const
+{
+    bool acceptsGzip = false;
+    bool acceptsBrotli = false;
+    for (const auto coding : acceptEncoding | std::views::split(',')) {
+        const auto codingStr = std::string_view(coding.begin(), coding.end());
+        const auto paramsPos = codingStr.find(';');
+        const auto name = trim(codingStr.substr(0, paramsPos));
+        if (paramsPos != std::string_view::npos) {
+            // Explicitly refused with q=0.
+            const auto params = trim(codingStr.substr(paramsPos + 1));
+            if (params == "q=0" || params == "q=0.0" || params == "q=0.00" || params == "q=0.000") {
+                continue;
+            }
+        }
+        if (name == "gzip") {
+            acceptsGzip = true;
+        } else if (name == "br") {
+            acceptsBrotli = true;
+        }
+    }
+
+    if (acceptsBrotli && brotli) {
+        return *brotli;
+    } else if (acceptsGzip && gzip) {
+        return *gzip;
+    }
+    return identity;
+}
+
+bool StaticFileCache::etagMatches(std::string_view ifNoneMatch, std::string_view etag)
+{
+    for (const auto candidate : ifNoneMatch | std::views::split(',')) {
+        auto candidateStr = trim(std::string_view(candidate.begin(), candidate.end()));
+        if (candidateStr == "*") {
+            return true;
+        }
+        // If-None-Match uses the weak comparison.
+        if (candidateStr.starts_with("W/")) {
+            candidateStr.remove_prefix(2);
+        }
+        if (candidateStr == etag) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string_view StaticFileCache::encodingName(Encoding encoding)
+{
+    switch (encoding) {
+    case Encoding::Identity:
+        return "identity";
+    case Encoding::Gzip:
+        return "gzip";
+    case Encoding::Brotli:
+        return "br";
+    }
+    return {};
+}
+
+std::string_view StaticFileCache::store(std::string data)
+{
+    return storage_.emplace_back(std::move(data));
+}
+
+} // namespace mobilesacn
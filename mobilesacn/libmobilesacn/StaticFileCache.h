@@ -0,0 +1,108 @@
+/**
+ * @file StaticFileCache.h
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#ifndef MOBILESACN_LIBMOBILESACN_STATICFILECACHE_H
+#define MOBILESACN_LIBMOBILESACN_STATICFILECACHE_H
+
+#include "embedded_webui.h"
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace mobilesacn {
+
+/**
+ * Immutable in-memory copy of the Web UI, with precompressed variants of every file.
+ *
+ * The files are either loaded from disk at startup or compiled into the program.
+ */
+class StaticFileCache
+{
+public:
+    using Ptr = std::shared_ptr<const StaticFileCache>;
+
+    enum class Encoding {
+        Identity,
+        Gzip,
+        Brotli,
+    };
+
+    struct Variant
+    {
+        Encoding encoding = Encoding::Identity;
+        std::string_view body;
+        /** Strong ETag for this variant, including quotes. */
+        std::string etag;
+    };
+
+    struct Entry
+    {
+        std::string contentType;
+        /** File name contains a content hash, so it may be cached forever. */
+        bool immutable = false;
+        Variant identity;
+        /** Only present if smaller than the identity variant. */
+        std::optional<Variant> gzip;
+        /** Only present if smaller than the identity variant. */
+        std::optional<Variant> brotli;
+
+        /**
+         * Pick the smallest variant the client accepts.
+         *
+         * @param acceptEncoding Value of the request's Accept-Encoding header.
+         */
+        [[nodiscard]] const Variant &negotiate(std::string_view acceptEncoding) const;
+    };
+
+    /**
+     * Load the Web UI.
+     *
+     * @param webRoot Every file under this directory is read into memory. Need not exist if
+     * @p embedded is not empty.
+     * @param embedded Files compiled into the program. These are served without copying, and take
+     * precedence over files in @p webRoot.
+     */
+    static Ptr load(
+        const std::filesystem::path &webRoot, std::span<const EmbeddedWebAsset> embedded = {});
+
+    /**
+     * Find the entry for @p path, relative to the web root and without a leading slash.
+     */
+    [[nodiscard]] const Entry *find(const std::string &path) const;
+
+    [[nodiscard]] std::size_t size() const { return entries_.size(); }
+
+    /**
+     * Check if @p ifNoneMatch (an If-None-Match header value) matches @p etag.
+     */
+    static bool etagMatches(std::string_view ifNoneMatch, std::string_view etag);
+
+    static std::string_view encodingName(Encoding encoding);
+
+private:
+    /**
+     * Owns the data every Variant::body points to when loaded from disk.
+     *
+     * Deque so elements never move.
+     */
+    std::deque<std::string> storage_;
+    std::unordered_map<std::string, Entry> entries_;
+
+    StaticFileCache() = default;
+    void addEmbedded(std::span<const EmbeddedWebAsset> assets);
+    void addFromDisk(const std::filesystem::path &webRoot);
+    std::string_view store(std::string data);
+};
+
+} // namespace mobilesacn
+
+#endif //MOBILESACN_LIBMOBILESACN_STATICFILECACHE_H
@@ -0,0 +1,223 @@
+/**
+ * @file Trace.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "Trace.h"
+#include <algorithm>
+#include <cstring>
+#include <fmt/format.h>
+#include <iterator>
+#if defined(OS_LINUX) || defined(OS_DARWIN)
+#include <pthread.h>
+#endif
+
+namespace mobilesacn {
+
+/**
+ * Get the OS name of the current thread. QThread sets this from its object name.
+ * @internal
+ */
+static std::string currentThreadName()
+{
+#if defined(OS_LINUX) || defined(OS_DARWIN)
+    std::array<char, 64> name{};
+    if (pthread_getname_np(pthread_self(), name.data(), name.size()) == 0 && name[0] != '\0') {
+        return name.data();
+    }
+#endif
+    return {};
+}
+
+/**
+ * Write @p str as the contents of a JSON string.
+ * @internal
+ */
+static void writeJsonEscaped(fmt::memory_buffer &out, std::string_view str)
+{
+    auto outIt = std::back_inserter(out);
+    for (const auto c : str) {
+        if (c == '"' || c == '\\') {
+            out.push_back('\\');
+            out.push_back(c);
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            fmt::format_to(outIt, "\\u{:04x}", static_cast<unsigned int>(c));
+        } else {
+            out.push_back(c);
+        }
+    }
+}
+
+Tracer &Tracer::get()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::Tracer() : epoch_(Clock::now()) {}
+
+void Tracer::setEnabled(bool enabled)
+{
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+Tracer::ThreadBufferLease::~ThreadBufferLease()
+{
+    if (buffer != nullptr) {
+        Tracer::get().releaseThreadBuffer(*buffer);
+    }
+}
+
+Tracer::ThreadBuffer &Tracer::threadBuffer()
+{
+    thread_local ThreadBufferLease lease;
+    if (lease.buffer == nullptr) {
+        // First span on this thread.
+        lease.buffer = &acquireThreadBuffer();
+    }
+    return *lease.buffer;
+}
+
+Tracer::ThreadBuffer &Tracer::acquireThreadBuffer()
+{
+    auto threadName = currentThreadName();
+    std::scoped_lock lock(buffersMutex_);
+    const auto it = std::ranges::find_if(
+        buffers_, [](const auto &buffer) { return !buffer->inUse; });
+    if (it != buffers_.end()) {
+        // Reuse a finished thread's buffer, discarding its spans.
+        auto &buffer = **it;
+        buffer.inUse = true;
+        buffer.tid = nextTid_++;
+        buffer.threadName = std::move(threadName);
+        buffer.clearedAt.store(
+            buffer.written.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return buffer;
+    }
+    auto &buffer = buffers_.emplace_back(std::make_shared<ThreadBuffer>());
+    buffer->tid = nextTid_++;
+    buffer->threadName = std::move(threadName);
+    return *buffer;
+}
+
+void Tracer::releaseThreadBuffer(ThreadBuffer &buffer)
+{
+    std::scoped_lock lock(buffersMutex_);
+    buffer.inUse = false;
+}
+
+void Tracer::record(
+    const char *name, Clock::time_point start, Clock::time_point end, std::string_view detail)
+{
+    if (!enabled()) {
+        return;
+    }
+    auto &buffer = threadBuffer();
+    const auto written = buffer.written.load(std::memory_order_relaxed);
+    auto &event = buffer.events[written % kEventsPerThread];
+    event.name = name;
+    event.startNs
+        = std::chrono::duration_cast<std::chrono::nanoseconds>(start - epoch_).count();
+    event.durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    const auto detailLength = std::min(detail.size(), kMaxDetailLength);
+    std::memcpy(event.detail.data(), detail.data(), detailLength);
+    event.detail[detailLength] = '\0';
+    buffer.written.store(written + 1, std::memory_order_release);
+}
+
+void Tracer::clear()
+{
+    std::scoped_lock lock(buffersMutex_);
+    for (const auto &buffer : buffers_) {
+        buffer->clearedAt.store(
+            buffer->written.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+std::string Tracer::toChromeJson() const
+{
+    struct BufferInfo
+    {
+        std::shared_ptr<ThreadBuffer> buffer;
+        uint32_t tid;
+        std::string threadName;
+    };
+    std::vector<BufferInfo> buffers;
+    {
+        // Copied, as a reused buffer gets a new thread's tid and name.
+        std::scoped_lock lock(buffersMutex_);
+        buffers.reserve(buffers_.size());
+        for (const auto &buffer : buffers_) {
+            buffers.push_back({buffer, buffer->tid, buffer->threadName});
+        }
+    }
+
+    fmt::memory_buffer out;
+    auto outIt = std::back_inserter(out);
+    fmt::format_to(outIt, R"({{"displayTimeUnit":"ms","traceEvents":[)");
+    bool first = true;
+    const auto separator = [&out, &first]() {
+        if (!first) {
+            out.push_back(',');
+        }
+        out.push_back('\n');
+        first = false;
+    };
+
+    std::vector<Event> events;
+    for (const auto &[buffer, tid, threadName] : buffers) {
+        if (!threadName.empty()) {
+            separator();
+            fmt::format_to(
+                outIt,
+                R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":")",
+                tid);
+            writeJsonEscaped(out, threadName);
+            fmt::format_to(outIt, R"("}}}})");
+        }
+
+        // Copy first, so the owning thread overwrites as little as possible while we work.
+        const auto end = buffer->written.load(std::memory_order_acquire);
+        const auto begin = std::max(
+            buffer->clearedAt.load(std::memory_order_relaxed),
+            end > kEventsPerThread ? end - kEventsPerThread : 0);
+        events.clear();
+        for (auto ix = begin; ix < end; ++ix) {
+            events.push_back(buffer->events[ix % kEventsPerThread]);
+        }
+        // Drop anything the owning thread overwrote during the copy, and the slot it may have been
+        // part way through writing.
+        const auto endAfterCopy = buffer->written.load(std::memory_order_acquire);
+        const auto overwritten = endAfterCopy + 1 > kEventsPerThread + begin
+                                     ? endAfterCopy + 1 - kEventsPerThread - begin
+                                     : 0;
+
+        for (auto event = events.cbegin() + std::min<std::size_t>(overwritten, events.size());
+             event != events.cend();
+             ++event) {
+            separator();
+            fmt::format_to(
+                outIt,
+                R"({{"name":"{}","cat":"mobilesacn","ph":"X","pid":1,)"
+                R"("tid":{},"ts":{:.3f},"dur":{:.3f})",
+                event->name,
+                tid,
+                static_cast<double>(event->startNs) / 1000.0,
+                static_cast<double>(event->durationNs) / 1000.0);
+            if (event->detail[0] != '\0') {
+                fmt::format_to(outIt, R"(,"args":{{"detail":")");
+                writeJsonEscaped(out, event->detail.data());
+                fmt::format_to(outIt, R"("}})");
+            }
+            out.push_back('}');
+        }
+    }
+    fmt::format_to(outIt, "\n]}}\n");
+
+    return fmt::to_string(out);
+}
+
+} // namespace mobilesacn
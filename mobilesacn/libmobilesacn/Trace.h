@@ -0,0 +1,183 @@
+/**
+ * @file Trace.h
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#ifndef MOBILESACN_LIBMOBILESACN_TRACE_H
+#define MOBILESACN_LIBMOBILESACN_TRACE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Trace the rest of the enclosing scope as a span.
+ *
+ * @param ... Arguments for mobilesacn::TraceSpan.
+ *
+ * @par Example
+ * @code{.cpp}
+ * void MergeReceiver::updateSources()
+ * {
+ *     MSACN_TRACE_SPAN("updateSources");
+ *     // ...
+ * }
+ * @endcode
+ */
+#define MSACN_TRACE_SPAN(...) \
+    const ::mobilesacn::TraceSpan MSACN_TRACE_CONCAT(msacnTraceSpan, __LINE__)(__VA_ARGS__)
+#define MSACN_TRACE_CONCAT(a, b) MSACN_TRACE_CONCAT_INNER(a, b)
+#define MSACN_TRACE_CONCAT_INNER(a, b) a##b
+
+namespace mobilesacn {
+
+/**
+ * Records spans into per-thread ring buffers, for export as a Chrome trace.
+ *
+ * Tracing is off until enabled. While off, a span costs a single relaxed atomic load. While on,
+ * recording a span never takes a lock; each thread writes only to its own buffer, overwriting its
+ * oldest spans once full.
+ */
+class Tracer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static Tracer &get();
+
+    Tracer(const Tracer &) = delete;
+    Tracer &operator=(const Tracer &) = delete;
+
+    [[nodiscard]] bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+    void setEnabled(bool enabled);
+
+    /**
+     * Record a span that has already finished.
+     *
+     * Does nothing if tracing is disabled.
+     *
+     * @param name Must outlive the tracer, e.g. a string literal.
+     * @param start
+     * @param end
+     * @param detail Shown as an argument on the span. Copied, and truncated if too long.
+     */
+    void record(
+        const char *name,
+        Clock::time_point start,
+        Clock::time_point end,
+        std::string_view detail = {});
+
+    /**
+     * Discard all recorded spans.
+     */
+    void clear();
+
+    /**
+     * Get every recorded span in Chrome's trace event JSON format.
+     *
+     * The result can be opened with Perfetto (https://ui.perfetto.dev) or chrome://tracing.
+     */
+    [[nodiscard]] std::string toChromeJson() const;
+
+private:
+    static constexpr std::size_t kEventsPerThread = 8192;
+    static constexpr std::size_t kMaxDetailLength = 47;
+
+    struct Event
+    {
+        const char *name;
+        int64_t startNs;
+        int64_t durationNs;
+        /** Null-terminated. */
+        std::array<char, kMaxDetailLength + 1> detail;
+    };
+
+    struct ThreadBuffer
+    {
+        /** Changed when the buffer is reused. Guarded by buffersMutex_. */
+        uint32_t tid = 0;
+        /** Guarded by buffersMutex_. */
+        std::string threadName;
+        /** FALSE once the owning thread exits. Guarded by buffersMutex_. */
+        bool inUse = true;
+        /** Total events ever written. Only written by the owning thread. */
+        std::atomic<uint64_t> written{0};
+        /** Events before this were discarded by clear(). */
+        std::atomic<uint64_t> clearedAt{0};
+        std::array<Event, kEventsPerThread> events;
+    };
+
+    /**
+     * Hands the current thread's buffer back for reuse when the thread exits.
+     */
+    struct ThreadBufferLease
+    {
+        ThreadBuffer *buffer = nullptr;
+        ~ThreadBufferLease();
+    };
+
+    std::atomic<bool> enabled_{false};
+    const Clock::time_point epoch_;
+    mutable std::mutex buffersMutex_;
+    /**
+     * Buffers outlive their threads, so spans from finished threads can still be exported. A new
+     * thread reuses a finished thread's buffer, so there are never more buffers than threads
+     * running at once.
+     */
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+    uint32_t nextTid_ = 1;
+
+    Tracer();
+    ThreadBuffer &threadBuffer();
+    ThreadBuffer &acquireThreadBuffer();
+    void releaseThreadBuffer(ThreadBuffer &buffer);
+};
+
+/**
+ * Record the time from construction to destruction as a span.
+ *
+ * Use MSACN_TRACE_SPAN() instead of creating these directly.
+ */
+class TraceSpan
+{
+public:
+    /**
+     * @param name Must outlive the tracer, e.g. a string literal.
+     * @param detail Must outlive the span.
+     */
+    explicit TraceSpan(const char *name, std::string_view detail = {}) :
+        name_(Tracer::get().enabled() ? name : nullptr), detail_(detail)
+    {
+        if (name_ != nullptr) {
+            start_ = Tracer::Clock::now();
+        }
+    }
+
+    ~TraceSpan()
+    {
+        if (name_ != nullptr) {
+            Tracer::get().record(name_, start_, Tracer::Clock::now(), detail_);
+        }
+    }
+
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+    /** nullptr if tracing was disabled when the span started. */
+    const char *name_;
+    std::string_view detail_;
+    Tracer::Clock::time_point start_;
+};
+
+} // namespace mobilesacn
+
+#endif //MOBILESACN_LIBMOBILESACN_TRACE_H
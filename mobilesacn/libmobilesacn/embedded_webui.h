@@ -0,0 +1,46 @@
+/**
+ * @file embedded_webui.h
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#ifndef MOBILESACN_LIBMOBILESACN_EMBEDDED_WEBUI_H
+#define MOBILESACN_LIBMOBILESACN_EMBEDDED_WEBUI_H
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace mobilesacn {
+
+/**
+ * A Web UI file compiled into the program.
+ */
+struct EmbeddedWebAsset
+{
+    /** Path relative to the web root, without a leading slash. */
+    std::string_view path;
+    std::string_view contentType;
+    /** Content hash, used to build ETags. */
+    std::string_view hash;
+    /** File name contains a content hash, so it may be cached forever. */
+    bool immutable;
+    std::span<const uint8_t> identity;
+    /** Empty if not worth compressing. */
+    std::span<const uint8_t> gzip;
+    /** Empty if not worth compressing. */
+    std::span<const uint8_t> brotli;
+};
+
+/**
+ * Get the Web UI files compiled into the program.
+ *
+ * Generated at build time by webui_embedder.
+ */
+std::span<const EmbeddedWebAsset> embeddedWebAssets();
+
+} // namespace mobilesacn
+
+#endif //MOBILESACN_LIBMOBILESACN_EMBEDDED_WEBUI_H
@@ -0,0 +1,123 @@
+/**
+ * @file AlertRules.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "AlertRules.h"
+#include "mobilesacn/libmobilesacn/Trace.h"
+#include <algorithm>
+#include <span>
+
+namespace mobilesacn::handler {
+
+/**
+ * Highest level in @p levels.
+ *
+ * A plain reduction, so the compiler vectorizes it.
+ * @internal
+ */
+static uint8_t maxLevel(std::span<const uint8_t> levels)
+{
+    uint8_t max = 0;
+    for (const auto level : levels) {
+        max = std::max(max, level);
+    }
+    return max;
+}
+
+/**
+ * Are @p lhs and @p rhs different?
+ *
+ * Written without an early exit, so the compiler vectorizes it.
+ * @internal
+ */
+static bool differs(std::span<const uint8_t> lhs, std::span<const uint8_t> rhs)
+{
+    uint8_t diff = 0;
+    for (std::size_t ix = 0; ix < lhs.size(); ++ix) {
+        diff |= static_cast<uint8_t>(lhs[ix] ^ rhs[ix]);
+    }
+    return diff != 0;
+}
+
+void AlertRules::setRules(const std::vector<Rule> &rules)
+{
+    rules_.clear();
+    for (auto rule : rules) {
+        switch (rule.kind) {
+        case Kind::LevelAbove:
+        case Kind::Changed:
+            if (rule.start >= kSacnDmxAddressCount) {
+                continue;
+            }
+            rule.count = std::min<uint16_t>(rule.count, kSacnDmxAddressCount - rule.start);
+            if (rule.count == 0) {
+                continue;
+            }
+            break;
+        case Kind::SourcesBelow:
+            // Not about addresses.
+            rule.start = 0;
+            rule.count = 0;
+            break;
+        default:
+            // Unknown kind, e.g. from a newer client.
+            continue;
+        }
+        rules_.push_back({.rule = rule});
+    }
+}
+
+void AlertRules::rearm()
+{
+    for (auto &state : rules_) {
+        state.active = false;
+        state.reference.reset();
+    }
+}
+
+void AlertRules::evaluate(const Buffer &levels, std::size_t sourceCount, std::vector<Event> &events)
+{
+    MSACN_TRACE_SPAN("AlertRules::evaluate");
+    for (auto &state : rules_) {
+        const auto &rule = state.rule;
+        // Empty for rules not about addresses.
+        const auto range = std::span(levels).subspan(rule.start, rule.count);
+        bool active = false;
+        if (rule.kind == Kind::LevelAbove) {
+            active = maxLevel(range) > rule.level;
+        } else if (rule.kind == Kind::Changed) {
+            if (!state.reference) {
+                state.reference.emplace(range.begin(), range.end());
+            }
+            active = differs(range, *state.reference);
+        } else if (rule.kind == Kind::SourcesBelow) {
+            active = sourceCount < rule.sources;
+        }
+        if (active == state.active) {
+            continue;
+        }
+
+        state.active = active;
+        Event event{.id = rule.id, .active = active};
+        if (active && rule.kind != Kind::SourcesBelow) {
+            // Only look for the culprit when the rule trips, which is rare.
+            for (std::size_t ix = 0; ix < range.size(); ++ix) {
+                const bool culprit = rule.kind == Kind::LevelAbove
+                                         ? range[ix] > rule.level
+                                         : range[ix] != (*state.reference)[ix];
+                if (culprit) {
+                    event.address = static_cast<uint16_t>(rule.start + ix);
+                    event.level = range[ix];
+                    break;
+                }
+            }
+        }
+        events.push_back(event);
+    }
+}
+
+} // namespace mobilesacn::handler
@@ -0,0 +1,99 @@
+/**
+ * @file AlertRules.h
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#ifndef MOBILESACN_LIBMOBILESACN_HANDLER_ALERTRULES_H
+#define MOBILESACN_LIBMOBILESACN_HANDLER_ALERTRULES_H
+
+#include "sacn/common.h"
+#include <array>
+#include <optional>
+#include <vector>
+
+namespace mobilesacn::handler {
+
+/**
+ * Watch a universe for problems described by a client, and report when they start and stop.
+ *
+ * Only changes are reported, so a client can watch for problems without receiving levels.
+ */
+class AlertRules
+{
+public:
+    using Buffer = std::array<uint8_t, kSacnDmxAddressCount>;
+
+    enum class Kind : uint8_t
+    {
+        /** Any address in the range is above the level. */
+        LevelAbove,
+        /** Any address in the range differs from its level when the rule was armed. */
+        Changed,
+        /** Fewer sources than the count are sending the universe. */
+        SourcesBelow,
+    };
+
+    struct Rule
+    {
+        /** Chosen by the client, to tell events apart. */
+        uint32_t id = 0;
+        Kind kind = Kind::LevelAbove;
+        /** Address - 1. */
+        uint16_t start = 0;
+        uint16_t count = 0;
+        uint8_t level = 0;
+        std::size_t sources = 0;
+    };
+
+    struct Event
+    {
+        uint32_t id = 0;
+        /** TRUE if the problem started, FALSE if it stopped. */
+        bool active = false;
+        /** First address with the problem (address - 1), for rules about addresses. */
+        std::optional<uint16_t> address;
+        /** Level at that address. */
+        uint8_t level = 0;
+    };
+
+    /**
+     * Replace the rules.
+     *
+     * Ranges are clipped to the universe. Rules of an unknown kind and rules about no addresses are
+     * dropped.
+     */
+    void setRules(const std::vector<Rule> &rules);
+
+    /**
+     * Start over as if the rules were just set, e.g. when the universe changes.
+     */
+    void rearm();
+
+    [[nodiscard]] bool empty() const { return rules_.empty(); }
+
+    /**
+     * Check a merged frame against every rule.
+     *
+     * @param levels
+     * @param sourceCount Number of sources sending the universe.
+     * @param events Rules that started or stopped are appended to this.
+     */
+    void evaluate(const Buffer &levels, std::size_t sourceCount, std::vector<Event> &events);
+
+private:
+    struct State
+    {
+        Rule rule;
+        bool active = false;
+        /** For Changed rules, the levels in the range when armed, or nothing if not armed yet. */
+        std::optional<std::vector<uint8_t>> reference;
+    };
+    std::vector<State> rules_;
+};
+
+} // namespace mobilesacn::handler
+
+#endif //MOBILESACN_LIBMOBILESACN_HANDLER_ALERTRULES_H
@@ -7,14 +7,28 @@
  */
 
 #include "BaseHandler.h"
+#include "mobilesacn/libmobilesacn/Trace.h"
 #include <spdlog/spdlog.h>
 
 namespace mobilesacn {
 
-BaseHandler::BaseHandler(QWebSocket *ws, QObject *parent) : QObject(parent), ws_(ws)
+BaseHandler::BaseHandler(QWebSocket *ws, QObject *parent) :
+    QObject(parent),
+    ws_(ws),
+    peerName_(QStringLiteral("%1:%2")
+                  .arg(ws->peerAddress().toString())
+                  .arg(ws->peerPort())
+                  .toStdString()),
+    activeHandlers_(Metrics::get().activeHandlers(ws->requestUrl().path().mid(1)))
 {
     ws->setParent(this);
     connect(ws, &QWebSocket::disconnected, this, &BaseHandler::onDisconnected);
+    connect(ws, &QWebSocket::bytesWritten, this, &BaseHandler::onBytesWritten);
+    latency_ = LatencyTracker::get().registerClient(
+        QStringLiteral("%1 %2").arg(ws->peerAddress().toString(), ws->requestUrl().path()));
+    metrics_ = Metrics::get().registerClient(
+        ws->requestUrl().path().mid(1), QString::fromStdString(peerName_));
+    activeHandlers_.add();
 
     // As these slots can slow the program down, only call them when they might actually do something.
 #if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
@@ -23,18 +37,21 @@ BaseHandler::BaseHandler(QWebSocket *ws, QObject *parent) : QObject(parent), ws_
 #endif
 
     SPDLOG_INFO(
-        "Started {} handler for client {}",
-        ws->requestUrl().path().toStdString(),
-        ws->peerAddress().toString().toStdString());
+        "Started {} handler for client {}", ws->requestUrl().path().toStdString(), peerName_);
+}
+
+BaseHandler::~BaseHandler()
+{
+    activeHandlers_.sub();
 }
 
 void BaseHandler::sendBinaryMessage(const QByteArrayView data) const
 {
-    SPDLOG_TRACE(
-        "Sending binary message to {}: {} bytes",
-        ws_->peerAddress().toString().toStdString(),
-        data.size());
+    SPDLOG_TRACE("Sending binary message to {}: {} bytes", peerName_, data.size());
     ws_->sendBinaryMessage({data.data(), data.size()});
+    bytesQueued_ += frameSize(data.size());
+    metrics_->messagesSent.add();
+    metrics_->bytesSent.add(data.size());
 }
 
 void BaseHandler::sendBinaryMessage(const uint8_t *const ptr, const qsizetype size) const
@@ -43,39 +60,78 @@ void BaseHandler::sendBinaryMessage(const uint8_t *const ptr, const qsizetype si
     sendBinaryMessage({reinterpret_cast<const char *>(ptr), size});
 }
 
+void BaseHandler::sendBinaryMessage(
+    const uint8_t *const ptr, const qsizetype size, const FrameTiming &timing) const
+{
+    sendBinaryMessage(ptr, size);
+    pendingWrites_.push_back({.endOffset = bytesQueued_, .timing = timing});
+}
+
 void BaseHandler::sendTextMessage(const QString &str) const
 {
-    SPDLOG_TRACE(
-        "Sending text message to {}: {} chars",
-        ws_->peerAddress().toString().toStdString(),
-        str.size());
+    SPDLOG_TRACE("Sending text message to {}: {} chars", peerName_, str.size());
     ws_->sendTextMessage(str);
+    const auto size = str.toUtf8().size();
+    bytesQueued_ += frameSize(size);
+    metrics_->messagesSent.add();
+    metrics_->bytesSent.add(size);
+}
+
+qint64 BaseHandler::frameSize(const qint64 payloadSize)
+{
+    // Server frames are not masked, so the header is only the opcode byte and the length.
+    if (payloadSize < 126) {
+        return payloadSize + 2;
+    } else if (payloadSize <= 0xFFFF) {
+        return payloadSize + 4;
+    }
+    return payloadSize + 10;
+}
+
+void BaseHandler::completeWrite(const PendingWrite &write) const
+{
+    const auto now = std::chrono::steady_clock::now();
+    Tracer::get().record("Socket write", write.timing.encoded, now, peerName_);
+    const auto sendTime = now - write.timing.encoded;
+    const auto totalTime = now - write.timing.arrival;
+    latency_->send.record(sendTime);
+    latency_->total.record(totalTime);
+    if (write.timing.universeLatency != nullptr) {
+        write.timing.universeLatency->send.record(sendTime);
+        write.timing.universeLatency->total.record(totalTime);
+    }
+}
+
+void BaseHandler::onBytesWritten(const qint64 bytes)
+{
+    bytesWritten_ += bytes;
+    if (ws_->bytesToWrite() == 0) {
+        // Everything queued has been written. Resynchronize in case our frame size accounting
+        // drifted from what the socket reports.
+        bytesWritten_ = bytesQueued_;
+    }
+    while (!pendingWrites_.empty() && pendingWrites_.front().endOffset <= bytesWritten_) {
+        completeWrite(pendingWrites_.front());
+        pendingWrites_.pop_front();
+    }
 }
 
 void BaseHandler::onDisconnected()
 {
     SPDLOG_INFO(
-        "Closing {} handler for client {}",
-        ws_->requestUrl().path().toStdString(),
-        ws_->peerAddress().toString().toStdString());
+        "Closing {} handler for client {}", ws_->requestUrl().path().toStdString(), peerName_);
     Q_EMIT(stopped(getDisplayName(), ws_->peerAddress()));
     deleteLater();
 }
 
 void BaseHandler::logBinaryMessage(const QByteArray &message)
 {
-    SPDLOG_TRACE(
-        "Received binary message from {}: {} bytes",
-        ws_->peerAddress().toString().toStdString(),
-        message.size());
+    SPDLOG_TRACE("Received binary message from {}: {} bytes", peerName_, message.size());
 }
 
 void BaseHandler::logTextMessage(const QString &message)
 {
-    SPDLOG_TRACE(
-        "Received text message from {}: {} bytes",
-        ws_->peerAddress().toString().toStdString(),
-        message.size());
+    SPDLOG_TRACE("Received text message from {}: {} bytes", peerName_, message.size());
 }
 
 } // namespace mobilesacn
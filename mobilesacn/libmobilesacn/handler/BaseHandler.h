@@ -9,6 +9,11 @@
 #ifndef MOBILESACN_LIBMOBILESACN_HANDLER_BASEHANDLER_H
 #define MOBILESACN_LIBMOBILESACN_HANDLER_BASEHANDLER_H
 
+#include "mobilesacn/libmobilesacn/Latency.h"
+#include "mobilesacn/libmobilesacn/Metrics.h"
+#include <deque>
+#include <memory>
+#include <string>
 #include <QWebSocket>
 
 namespace mobilesacn {
@@ -26,6 +31,7 @@ class BaseHandler : public QObject
 
 public:
     explicit BaseHandler(QWebSocket *ws, QObject *parent = nullptr);
+    ~BaseHandler() override;
 
     /**
      * Supported protocol name.
@@ -44,15 +50,49 @@ protected:
     [[nodiscard]] QWebSocket *ws() const { return ws_; }
     void sendBinaryMessage(QByteArrayView data) const;
     void sendBinaryMessage(const uint8_t *ptr, qsizetype size) const;
+    /**
+     * Send a message and record its latency once it has been written to the socket.
+     */
+    void sendBinaryMessage(const uint8_t *ptr, qsizetype size, const FrameTiming &timing) const;
     void sendTextMessage(const QString &str) const;
+    /**
+     * Latency histograms for this client.
+     */
+    [[nodiscard]] FrameLatency &latency() const { return *latency_; }
 
 private:
     QWebSocket *ws_;
+    /** Client address and port, formatted once for logging. */
+    std::string peerName_;
+    std::shared_ptr<FrameLatency> latency_;
+    MetricGauge &activeHandlers_;
+    std::shared_ptr<ClientMetrics> metrics_;
+
+    /**
+     * A timed message waiting to be written to the socket.
+     */
+    struct PendingWrite
+    {
+        /** Total bytes queued on the socket once this message has been written. */
+        qint64 endOffset;
+        FrameTiming timing;
+    };
+    // Write tracking is bookkeeping only, so it is allowed from const sends.
+    mutable std::deque<PendingWrite> pendingWrites_;
+    mutable qint64 bytesQueued_ = 0;
+    mutable qint64 bytesWritten_ = 0;
+
+    /**
+     * Size of a message with @p payloadSize bytes once framed, as reported by QWebSocket::bytesWritten().
+     */
+    static qint64 frameSize(qint64 payloadSize);
+    void completeWrite(const PendingWrite &write) const;
 
 private Q_SLOTS:
     void logBinaryMessage(const QByteArray &message);
     void logTextMessage(const QString &message);
     void onDisconnected();
+    void onBytesWritten(qint64 bytes);
 };
 
 } // namespace mobilesacn
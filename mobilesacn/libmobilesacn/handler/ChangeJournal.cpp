@@ -0,0 +1,117 @@
+/**
+ * @file ChangeJournal.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "ChangeJournal.h"
+#include "mobilesacn/libmobilesacn/Trace.h"
+
+namespace mobilesacn::handler {
+
+void ChangeJournal::record(
+    Clock::time_point time,
+    const Buffer &oldLevels,
+    const Buffer &newLevels,
+    const std::array<std::string, kSacnDmxAddressCount> &owners)
+{
+    if (oldLevels == newLevels) {
+        return;
+    }
+    MSACN_TRACE_SPAN("ChangeJournal::record");
+    std::scoped_lock lock(mutex_);
+    for (std::size_t address = 0; address < kSacnDmxAddressCount; ++address) {
+        if (oldLevels[address] == newLevels[address]) {
+            continue;
+        }
+        const auto sequence = next_++;
+        auto &last = lastByAddress_[address];
+        const auto distance = last == 0 ? 0 : sequence - (last - 1);
+        last = sequence + 1;
+        const Entry entry{
+            .time = time.time_since_epoch().count(),
+            .address = static_cast<uint16_t>(address),
+            .oldLevel = oldLevels[address],
+            .newLevel = newLevels[address],
+            .owner = ownerId(owners[address]),
+            .previous = static_cast<uint16_t>(distance < kCapacity ? distance : 0),
+        };
+        if (entries_.size() < kCapacity) {
+            entries_.push_back(entry);
+        } else {
+            entries_[sequence % kCapacity] = entry;
+        }
+    }
+}
+
+std::vector<ChangeJournal::Change> ChangeJournal::query(const Query &query) const
+{
+    MSACN_TRACE_SPAN("ChangeJournal::query");
+    const auto from = query.from.time_since_epoch().count();
+    const auto to = query.to.time_since_epoch().count();
+    std::vector<Change> changes;
+    std::scoped_lock lock(mutex_);
+    const auto oldest = this->oldest();
+
+    if (query.address) {
+        // Follow the links between changes to this address.
+        if (*query.address >= kSacnDmxAddressCount || lastByAddress_[*query.address] == 0) {
+            return changes;
+        }
+        auto sequence = lastByAddress_[*query.address] - 1;
+        while (sequence >= oldest && changes.size() < query.limit) {
+            const auto &entry = entries_[sequence % kCapacity];
+            if (entry.time < from) {
+                break;
+            }
+            if (entry.time <= to) {
+                changes.push_back(toChange(entry));
+            }
+            if (entry.previous == 0 || sequence - oldest < entry.previous) {
+                break;
+            }
+            sequence -= entry.previous;
+        }
+        return changes;
+    }
+
+    for (auto sequence = next_; sequence > oldest && changes.size() < query.limit; --sequence) {
+        const auto &entry = entries_[(sequence - 1) % kCapacity];
+        if (entry.time < from) {
+            break;
+        }
+        if (entry.time <= to) {
+            changes.push_back(toChange(entry));
+        }
+    }
+    return changes;
+}
+
+uint16_t ChangeJournal::ownerId(const std::string &cid)
+{
+    if (const auto it = ownerIds_.find(cid); it != ownerIds_.cend()) {
+        return it->second;
+    }
+    if (owners_.size() == kMaxOwners) {
+        return 0;
+    }
+    const auto id = static_cast<uint16_t>(owners_.size());
+    owners_.push_back(cid);
+    ownerIds_.emplace(cid, id);
+    return id;
+}
+
+ChangeJournal::Change ChangeJournal::toChange(const Entry &entry) const
+{
+    return Change{
+        .time = Clock::time_point(Clock::duration(entry.time)),
+        .address = entry.address,
+        .oldLevel = entry.oldLevel,
+        .newLevel = entry.newLevel,
+        .owner = owners_[entry.owner],
+    };
+}
+
+} // namespace mobilesacn::handler
@@ -0,0 +1,114 @@
+/**
+ * @file ChangeJournal.h
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#ifndef MOBILESACN_LIBMOBILESACN_HANDLER_CHANGEJOURNAL_H
+#define MOBILESACN_LIBMOBILESACN_HANDLER_CHANGEJOURNAL_H
+
+#include "sacn/common.h"
+#include <array>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mobilesacn::handler {
+
+/**
+ * Remember the most recent level changes on a universe.
+ *
+ * Holds at most kCapacity changes; the oldest are overwritten first. Each change links to the
+ * previous change to its address, so the history of one address is found without scanning.
+ *
+ * Thread-safe.
+ */
+class ChangeJournal
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Buffer = std::array<uint8_t, kSacnDmxAddressCount>;
+
+    static constexpr std::size_t kCapacity = 1 << 16;
+    /** Distinct owners remembered. Owners after this are recorded as no owner. */
+    static constexpr std::size_t kMaxOwners = std::numeric_limits<uint16_t>::max();
+
+    struct Change
+    {
+        Clock::time_point time;
+        /** Address - 1. */
+        uint16_t address = 0;
+        uint8_t oldLevel = 0;
+        uint8_t newLevel = 0;
+        /** CID of the source that owned the address after the change, or empty. */
+        std::string owner;
+    };
+
+    struct Query
+    {
+        /** Address - 1, or nothing for every address. */
+        std::optional<uint16_t> address;
+        Clock::time_point from = Clock::time_point::min();
+        Clock::time_point to = Clock::time_point::max();
+        std::size_t limit = kCapacity;
+    };
+
+    /**
+     * Record every address that differs between @p oldLevels and @p newLevels.
+     *
+     * @param time When the new levels arrived. Must not be before the last recorded time.
+     * @param oldLevels
+     * @param newLevels
+     * @param owners CID of the source that owns each address in @p newLevels, or empty.
+     */
+    void record(
+        Clock::time_point time,
+        const Buffer &oldLevels,
+        const Buffer &newLevels,
+        const std::array<std::string, kSacnDmxAddressCount> &owners);
+
+    /**
+     * Get changes matching @p query, newest first.
+     */
+    [[nodiscard]] std::vector<Change> query(const Query &query) const;
+
+private:
+    /** Kept small, as there are kCapacity of them per universe. */
+    struct Entry
+    {
+        Clock::rep time = 0;
+        uint16_t address = 0;
+        uint8_t oldLevel = 0;
+        uint8_t newLevel = 0;
+        /** Index into owners_. */
+        uint16_t owner = 0;
+        /** How many entries back the previous change to this address is, or 0 if forgotten. */
+        uint16_t previous = 0;
+    };
+    static_assert(sizeof(Entry) == 16);
+
+    mutable std::mutex mutex_;
+    /** Ring buffer, where the entry with sequence number n is at n % kCapacity. */
+    std::vector<Entry> entries_;
+    /** Sequence number of the next entry. */
+    uint64_t next_ = 0;
+    /** Sequence number + 1 of the last change to each address, or 0 if there was none. */
+    std::array<uint64_t, kSacnDmxAddressCount> lastByAddress_{};
+    /** Index 0 is no owner. */
+    std::vector<std::string> owners_{std::string()};
+    std::unordered_map<std::string, uint16_t> ownerIds_{{std::string(), 0}};
+
+    [[nodiscard]] uint64_t oldest() const { return next_ > kCapacity ? next_ - kCapacity : 0; }
+    uint16_t ownerId(const std::string &cid);
+    [[nodiscard]] Change toChange(const Entry &entry) const;
+};
+
+} // namespace mobilesacn::handler
+
+#endif //MOBILESACN_LIBMOBILESACN_HANDLER_CHANGEJOURNAL_H
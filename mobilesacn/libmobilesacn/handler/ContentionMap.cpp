@@ -0,0 +1,62 @@
+/**
+ * @file ContentionMap.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "ContentionMap.h"
+#include "mobilesacn/libmobilesacn/Trace.h"
+#include <algorithm>
+
+namespace mobilesacn::handler {
+
+/**
+ * All ones if @p value is true, otherwise 0.
+ * @internal
+ */
+static uint8_t mask(bool value)
+{
+    return static_cast<uint8_t>(-static_cast<uint8_t>(value));
+}
+
+void ContentionMap::compute(std::span<const Input> inputs, Result &result)
+{
+    MSACN_TRACE_SPAN("ContentionMap::compute");
+    // Highest priority so far, and the range of levels sent at it.
+    Buffer winning{};
+    Buffer low{};
+    Buffer high{};
+    result.counts.fill(0);
+    const auto count = std::min(inputs.size(), kMaxSources);
+    for (std::size_t ix = 0; ix < count; ++ix) {
+        const auto &levels = *inputs[ix].levels;
+        const auto &priorities = *inputs[ix].priorities;
+        // Written without branches so the compiler vectorizes it.
+        for (std::size_t address = 0; address < kSacnDmxAddressCount; ++address) {
+            const auto priority = priorities[address];
+            const auto level = levels[address];
+            const auto higher = mask(priority > winning[address]);
+            const auto tied = static_cast<uint8_t>(
+                mask(priority == winning[address]) & mask(priority != 0));
+            const auto kept = static_cast<uint8_t>(~(higher | tied));
+            result.counts[address] = static_cast<uint8_t>(
+                (result.counts[address] & ~higher) + (higher & 1) + (tied & 1));
+            low[address] = static_cast<uint8_t>(
+                (level & higher) | (std::min(low[address], level) & tied) | (low[address] & kept));
+            high[address] = static_cast<uint8_t>(
+                (level & higher) | (std::max(high[address], level) & tied)
+                | (high[address] & kept));
+            winning[address] = std::max(priority, winning[address]);
+        }
+    }
+
+    result.htp.fill(0);
+    for (std::size_t address = 0; address < kSacnDmxAddressCount; ++address) {
+        const bool htp = result.counts[address] > 1 && low[address] != high[address];
+        result.htp[address / 8] |= static_cast<uint8_t>(htp << (address % 8));
+    }
+}
+
+} // namespace mobilesacn::handler
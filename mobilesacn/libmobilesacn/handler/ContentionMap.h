@@ -0,0 +1,60 @@
+/**
+ * @file ContentionMap.h
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#ifndef MOBILESACN_LIBMOBILESACN_HANDLER_CONTENTIONMAP_H
+#define MOBILESACN_LIBMOBILESACN_HANDLER_CONTENTIONMAP_H
+
+#include "sacn/common.h"
+#include <array>
+#include <span>
+
+namespace mobilesacn::handler {
+
+/**
+ * Find addresses where more than one source is sending at the winning priority.
+ *
+ * Priority decides the merge first, so these are the only addresses where sources can fight.
+ */
+class ContentionMap
+{
+public:
+    using Buffer = std::array<uint8_t, kSacnDmxAddressCount>;
+    /** One bit per address, with address 1 in the low bit of the first byte. */
+    using Bitmap = std::array<uint8_t, kSacnDmxAddressCount / 8>;
+
+    static constexpr std::size_t kMaxSources = 255;
+
+    struct Input
+    {
+        const Buffer *levels = nullptr;
+        /** Per-address priorities, where 0 means the source is not sending that address. */
+        const Buffer *priorities = nullptr;
+    };
+
+    struct Result
+    {
+        /** Number of sources sending each address at its winning priority. */
+        Buffer counts{};
+        /** Set where those sources disagree on the level, so HTP picks the winner. */
+        Bitmap htp{};
+
+        bool operator==(const Result &) const = default;
+    };
+
+    /**
+     * Find contention between @p inputs.
+     *
+     * @param inputs Only the first kMaxSources are used.
+     * @param result
+     */
+    static void compute(std::span<const Input> inputs, Result &result);
+};
+
+} // namespace mobilesacn::handler
+
+#endif //MOBILESACN_LIBMOBILESACN_HANDLER_CONTENTIONMAP_H
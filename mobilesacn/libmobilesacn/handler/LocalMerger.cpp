@@ -0,0 +1,69 @@
+/**
+ * @file LocalMerger.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "LocalMerger.h"
+#include "mobilesacn/libmobilesacn/Trace.h"
+#include <algorithm>
+
+namespace mobilesacn::handler {
+
+/** Priority in the high byte and level in the low byte, so the winner is the largest key. */
+using MergeKeys = std::array<uint16_t, kSacnDmxAddressCount>;
+
+/**
+ * Merge one source into @p keys and @p owners.
+ *
+ * Written without branches so the compiler vectorizes it.
+ * @internal
+ */
+template <bool kOverride>
+static void mergeSource(
+    const LocalMerger::Buffer &levels,
+    const LocalMerger::Buffer &priorities,
+    uint8_t priorityOverride,
+    uint8_t owner,
+    MergeKeys &keys,
+    LocalMerger::Buffer &owners)
+{
+    for (std::size_t address = 0; address < kSacnDmxAddressCount; ++address) {
+        // All ones if the source is sending this address, otherwise 0.
+        const auto sending = static_cast<uint8_t>(-static_cast<uint8_t>(priorities[address] != 0));
+        const uint8_t priority = kOverride ? (priorityOverride & sending) : priorities[address];
+        const auto key = static_cast<uint16_t>((priority << 8) | (levels[address] & sending));
+        const auto wins = static_cast<uint8_t>(-static_cast<uint8_t>(key > keys[address]));
+        keys[address] = std::max(key, keys[address]);
+        owners[address] = static_cast<uint8_t>((owner & wins) | (owners[address] & ~wins));
+    }
+}
+
+void LocalMerger::merge(std::span<const Input> inputs, Result &result)
+{
+    MSACN_TRACE_SPAN("LocalMerger::merge");
+    MergeKeys keys{};
+    result.owners.fill(kNoOwner);
+    const auto count = std::min(inputs.size(), kMaxSources);
+    for (std::size_t ix = 0; ix < count; ++ix) {
+        const auto &input = inputs[ix];
+        const auto owner = static_cast<uint8_t>(ix);
+        const auto &levels = *input.levels;
+        const auto &priorities = *input.priorities;
+        if (!input.priorityOverride) {
+            mergeSource<false>(levels, priorities, 0, owner, keys, result.owners);
+        } else if (*input.priorityOverride != 0) {
+            mergeSource<true>(
+                levels, priorities, *input.priorityOverride, owner, keys, result.owners);
+        }
+    }
+
+    for (std::size_t address = 0; address < kSacnDmxAddressCount; ++address) {
+        result.priorities[address] = static_cast<uint8_t>(keys[address] >> 8);
+        result.levels[address] = static_cast<uint8_t>(keys[address] & 0xFF);
+    }
+}
+
+} // namespace mobilesacn::handler
@@ -0,0 +1,63 @@
+/**
+ * @file LocalMerger.h
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#ifndef MOBILESACN_LIBMOBILESACN_HANDLER_LOCALMERGER_H
+#define MOBILESACN_LIBMOBILESACN_HANDLER_LOCALMERGER_H
+
+#include "sacn/common.h"
+#include <array>
+#include <optional>
+#include <span>
+
+namespace mobilesacn::handler {
+
+/**
+ * Merge sources by priority, then HTP, like the sACN library does.
+ *
+ * The inputs are buffers kept by this program (see SourceTap), so they can be changed to see what
+ * the network would do, e.g. if a source dropped out or changed its priority.
+ */
+class LocalMerger
+{
+public:
+    using Buffer = std::array<uint8_t, kSacnDmxAddressCount>;
+
+    static constexpr uint8_t kNoOwner = 0xFF;
+    static constexpr std::size_t kMaxSources = kNoOwner;
+
+    struct Input
+    {
+        const Buffer *levels = nullptr;
+        /** Per-address priorities, where 0 means the source is not sending that address. */
+        const Buffer *priorities = nullptr;
+        /** Replaces every non-zero priority. 0 leaves the source out entirely. */
+        std::optional<uint8_t> priorityOverride;
+    };
+
+    struct Result
+    {
+        Buffer levels{};
+        Buffer priorities{};
+        /** Index into the inputs of the source that owns each address, or kNoOwner. */
+        Buffer owners{};
+    };
+
+    /**
+     * Merge @p inputs.
+     *
+     * Where sources tie on both priority and level, the earliest input wins.
+     *
+     * @param inputs Only the first kMaxSources are used.
+     * @param result
+     */
+    static void merge(std::span<const Input> inputs, Result &result);
+};
+
+} // namespace mobilesacn::handler
+
+#endif //MOBILESACN_LIBMOBILESACN_HANDLER_LOCALMERGER_H
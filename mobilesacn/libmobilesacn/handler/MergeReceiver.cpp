@@ -7,7 +7,13 @@
  */
 
 #include "MergeReceiver.h"
+#include "MergeReceiverPool.h"
+#include "SequenceMonitor.h"
 #include "mobilesacn/libmobilesacn/SacnSettings.h"
+#include "mobilesacn/libmobilesacn/Trace.h"
+#include "mobilesacn/libmobilesacn/util.h"
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <ranges>
 #include <spdlog/spdlog.h>
@@ -19,6 +25,7 @@ MergeReceiver::~MergeReceiver()
 {
     SPDLOG_DEBUG("Deleting sACN Receiver for univ {}", sacnSettings_.universe_id);
     receiver_.Shutdown();
+    SequenceMonitor::get()->unwatch(sacnSettings_.universe_id);
 }
 
 MergeReceiver::Ptr MergeReceiver::getForUniverse(uint16_t universe)
@@ -27,23 +34,25 @@ MergeReceiver::Ptr MergeReceiver::getForUniverse(uint16_t universe)
         throw std::logic_error("Cannot get receiver for universe 0");
     }
 
-    std::lock_guard receiverLock(receiversMutex_);
-    auto &weakReceiver = receivers_[universe];
-    auto receiver = weakReceiver.lock();
-    if (!receiver) {
-        receiver = std::make_shared<MergeReceiver>();
-        weakReceiver = receiver;
-        receiver->sacnSettings_.universe_id = universe;
-        receiver->sacnSettings_.footprint = {.start_address = 1, .address_count = kSacnDmxAddressCount};
-        receiver->sacnSettings_.use_pap = true;
-        receiver->startup();
-    }
+    return MergeReceiverPool::get()->acquire(universe);
+}
+
+MergeReceiver::Ptr MergeReceiver::create(uint16_t universe)
+{
+    auto receiver = std::make_shared<MergeReceiver>();
+    receiver->sacnSettings_.universe_id = universe;
+    receiver->sacnSettings_.footprint = {.start_address = 1, .address_count = kSacnDmxAddressCount};
+    receiver->sacnSettings_.use_pap = true;
+    receiver->startup();
+    // The sACN library does not report lost packets, so count them alongside it.
+    SequenceMonitor::get()->watch(universe);
     return receiver;
 }
 
 void MergeReceiver::startup()
 {
     SPDLOG_DEBUG("Creating sACN Receiver for univ {}", sacnSettings_.universe_id);
+    metrics_ = &Metrics::get().forUniverse(sacnSettings_.universe_id);
     const auto &sacnSettings = SacnSettings::get();
     sacnSettings_.ip_supported = sacnSettings->sacnNetInt.addr().IsV4()
                                      ? sacn_ip_support_t::kSacnIpV4Only
@@ -57,26 +66,57 @@ void MergeReceiver::startup()
     }
 }
 
-void MergeReceiver::shutdown()
+MergeReceiver::SourceSnapshot MergeReceiver::sources() const
 {
-    SPDLOG_DEBUG("Destroying sACN Receiver for univ {}", sacnSettings_.universe_id);
-    std::lock_guard lock(receiversMutex_);
-    receivers_.erase(sacnSettings_.universe_id);
+    std::scoped_lock sourcesLock(sourcesMutex_);
+    return sources_;
 }
 
-std::unordered_map<etcpal::Uuid, sacn::MergeReceiver::Source> MergeReceiver::sources() const
+MergedFrame::Ptr MergeReceiver::lastFrame() const
 {
     std::scoped_lock sourcesLock(sourcesMutex_);
-    // Return a copy to avoid threading issues.
-    return {sources_};
+    return lastFrame_;
+}
+
+void MergeReceiver::publish(SourceSnapshot sources)
+{
+    std::scoped_lock sourcesLock(sourcesMutex_);
+    sources_ = std::move(sources);
 }
 
 void MergeReceiver::HandleMergedData(
     sacn::MergeReceiver::Handle handle, const SacnRecvMergedData &merged_data)
 {
+    MSACN_TRACE_SPAN("HandleMergedData");
+    metrics_->framesReceived.add();
+    auto frame = std::make_shared<MergedFrame>();
+    frame->arrival = std::chrono::steady_clock::now();
+    frame->arrivalTimestamp = getNowInMilliseconds();
+    frame->universe = sacnSettings_.universe_id;
+
     updateSources(merged_data);
-    const auto ownerCids = getOwnerCids(merged_data);
-    Q_EMIT(dataChanged(merged_data, ownerCids));
+
+    // Determine where in addresses 1-512 our received data is.
+    const auto bufOffset = merged_data.slot_range.start_address - 1;
+    const auto bufCount
+        = std::min(merged_data.slot_range.address_count, static_cast<int>(kSacnDmxAddressCount));
+    std::memcpy(frame->levels.data() + bufOffset, merged_data.levels, bufCount);
+    std::memcpy(frame->priorities.data() + bufOffset, merged_data.priorities, bufCount);
+    frame->ownerCids = getOwnerCids(*sources_, merged_data);
+
+    // The first frame changes every address it sends from nothing.
+    static const ChangeJournal::Buffer kNoLevels{};
+    journal_.record(
+        frame->arrival,
+        lastFrame_ ? lastFrame_->levels : kNoLevels,
+        frame->levels,
+        frame->ownerCids);
+
+    {
+        std::scoped_lock sourcesLock(sourcesMutex_);
+        lastFrame_ = frame;
+    }
+    Q_EMIT(dataChanged(frame));
 }
 
 void MergeReceiver::HandleSourcesLost(
@@ -84,10 +124,14 @@ void MergeReceiver::HandleSourcesLost(
     uint16_t universe,
     const std::vector<SacnLostSource> &lostSources)
 {
+    // Readers may still hold the old snapshot, so change a copy.
+    auto updated = std::make_shared<SourceMap>(*sources_);
+    for (const auto &source : lostSources) {
+        updated->erase(etcpal::Uuid(source.cid));
+    }
+    publish(std::move(updated));
     for (const auto &source : lostSources) {
-        const auto cid = etcpal::Uuid(source.cid);
-        Q_EMIT(sourceLost(cid.ToString()));
-        sources_.erase(cid);
+        Q_EMIT(sourceLost(etcpal::Uuid(source.cid).ToString()));
     }
 }
 
@@ -105,31 +149,43 @@ bool operator==(const sacn::MergeReceiver::Source &a, const sacn::MergeReceiver:
 
 void MergeReceiver::updateSources(const SacnRecvMergedData &mergedData)
 {
-    // If we can't lock, don't wait, just try again on the next data packet.
-    std::unique_lock sourcesLock(sourcesMutex_, std::try_to_lock_t{});
-    if (!sourcesLock) {
-        return;
-    }
-
-    // Update sources.
+    MSACN_TRACE_SPAN("updateSources");
+    // Only copy the map if something changed, which is rare once sources are established.
+    std::shared_ptr<SourceMap> updated;
+    std::vector<sacn::MergeReceiver::Source> changed;
     for (std::size_t ix = 0; ix < mergedData.num_active_sources; ++ix) {
         const auto newSource = receiver_.GetSource(mergedData.active_sources[ix]);
         Q_ASSERT(newSource);
-        const auto cid = newSource->cid;
-        auto &oldSource = sources_[cid];
-        if (oldSource != *newSource) {
-            Q_EMIT(sourceUpdated(*newSource));
-            oldSource = *newSource;
+        const auto &current = updated ? *updated : *sources_;
+        const auto oldSource = current.find(newSource->cid);
+        if (oldSource != current.cend() && oldSource->second == *newSource) {
+            continue;
         }
+        if (!updated) {
+            updated = std::make_shared<SourceMap>(*sources_);
+        }
+        (*updated)[newSource->cid] = *newSource;
+        changed.push_back(*newSource);
+    }
+    if (!updated) {
+        return;
+    }
+
+    // Publish first, so anyone reacting to the signal sees the new sources.
+    publish(std::move(updated));
+    for (const auto &source : changed) {
+        Q_EMIT(sourceUpdated(source));
     }
 }
 
-std::array<std::string, 512> MergeReceiver::getOwnerCids(const SacnRecvMergedData &mergedData)
+std::array<std::string, kSacnDmxAddressCount> MergeReceiver::getOwnerCids(
+    const SourceMap &sources, const SacnRecvMergedData &mergedData)
 {
+    MSACN_TRACE_SPAN("getOwnerCids");
     // Get source CIDs.
     std::unordered_map<sacn_remote_source_t, std::string> handleCids;
-    handleCids.reserve(sources_.size());
-    for (const auto &source : sources_ | std::views::values) {
+    handleCids.reserve(sources.size());
+    for (const auto &source : sources | std::views::values) {
         handleCids.emplace(source.handle, source.cid.ToString());
     }
 
@@ -9,6 +9,10 @@
 #ifndef MOBILESACN_LIBMOBILESACN_HANDLER_MERGERECEIVER_H
 #define MOBILESACN_LIBMOBILESACN_HANDLER_MERGERECEIVER_H
 
+#include "ChangeJournal.h"
+#include "mobilesacn/libmobilesacn/Metrics.h"
+#include <chrono>
+#include <memory>
 #include <mutex>
 #include <sacn/cpp/merge_receiver.h>
 #include <sacn/merge_receiver.h>
@@ -16,6 +20,24 @@
 
 namespace mobilesacn::handler {
 
+/**
+ * A merged frame, copied out of the sACN library's buffers so it can be passed between threads.
+ */
+struct MergedFrame
+{
+    using Ptr = std::shared_ptr<const MergedFrame>;
+
+    uint16_t universe = 0;
+    std::array<uint8_t, kSacnDmxAddressCount> levels{};
+    std::array<uint8_t, kSacnDmxAddressCount> priorities{};
+    /** CID of the source that owns each address, or empty if the address has no owner. */
+    std::array<std::string, kSacnDmxAddressCount> ownerCids{};
+    /** When the frame arrived from the sACN library. */
+    std::chrono::steady_clock::time_point arrival;
+    /** Arrival time in milliseconds since the Unix epoch, for sending to clients. */
+    uint64_t arrivalTimestamp = 0;
+};
+
 /**
  * Wrap an sacn::MergeReceiver to handle multiple subscribers.
  */
@@ -25,9 +47,25 @@ class MergeReceiver : public QObject, public sacn::MergeReceiver::NotifyHandler
 
 public:
     using Ptr = std::shared_ptr<MergeReceiver>;
-
+    using SourceMap = std::unordered_map<etcpal::Uuid, sacn::MergeReceiver::Source>;
+    /** Immutable, so it can be read from any thread without locking. */
+    using SourceSnapshot = std::shared_ptr<const SourceMap>;
+
+    /**
+     * Get the shared receiver for @p universe, starting it if needed.
+     *
+     * Receivers are kept running for a while after the last subscriber lets go, so switching back
+     * is instant. See MergeReceiverPool.
+     */
     static Ptr getForUniverse(uint16_t universe);
 
+    /**
+     * Create and start a receiver for @p universe.
+     *
+     * Use getForUniverse() instead, so receivers are shared.
+     */
+    static Ptr create(uint16_t universe);
+
     MergeReceiver(const MergeReceiver &) = delete;
     MergeReceiver &operator=(const MergeReceiver &) = delete;
     ~MergeReceiver() override;
@@ -40,29 +78,47 @@ public:
         const std::vector<SacnLostSource> &lostSources) override;
 
     void startup();
-    void shutdown();
 
-    [[nodiscard]] std::unordered_map<etcpal::Uuid, sacn::MergeReceiver::Source> sources() const;
+    [[nodiscard]] uint16_t universe() const { return sacnSettings_.universe_id; }
+    [[nodiscard]] SourceSnapshot sources() const;
+    /**
+     * Get the most recent frame, or nullptr if none has arrived yet.
+     */
+    [[nodiscard]] MergedFrame::Ptr lastFrame() const;
+    [[nodiscard]] const ChangeJournal &journal() const { return journal_; }
+
+    /**
+     * Get the CID of the source that owns each address in @p mergedData.
+     *
+     * @param sources Known sources, used to look up the owner handles in @p mergedData.
+     * @param mergedData
+     * @return A list of CIDs ordered by address. Addresses with no owner have an empty CID.
+     */
+    static std::array<std::string, kSacnDmxAddressCount> getOwnerCids(
+        const SourceMap &sources, const SacnRecvMergedData &mergedData);
 
 Q_SIGNALS:
-    void dataChanged(
-        const SacnRecvMergedData &merged_data,
-        const std::array<std::string, kSacnDmxAddressCount> &ownerCids);
+    void dataChanged(const MergedFrame::Ptr &frame);
     void sourceUpdated(const sacn::MergeReceiver::Source &source);
     void sourceLost(const std::string &cid);
 
 private:
-    static inline std::mutex receiversMutex_;
-    static inline std::unordered_map<uint16_t, std::weak_ptr<MergeReceiver>> receivers_;
     sacn::MergeReceiver::Settings sacnSettings_;
     sacn::MergeReceiver receiver_;
+    /**
+     * Only guards swapping sources_ and lastFrame_, which are otherwise only changed on the sACN
+     * thread.
+     */
     mutable std::mutex sourcesMutex_;
-    std::unordered_map<etcpal::Uuid, sacn::MergeReceiver::Source> sources_;
+    SourceSnapshot sources_ = std::make_shared<const SourceMap>();
+    MergedFrame::Ptr lastFrame_;
+    ChangeJournal journal_;
+    UniverseMetrics *metrics_ = nullptr;
 
     using QObject::QObject;
 
     void updateSources(const SacnRecvMergedData &mergedData);
-    std::array<std::string, kSacnDmxAddressCount> getOwnerCids(const SacnRecvMergedData &mergedData);
+    void publish(SourceSnapshot sources);
 };
 
 } // namespace mobilesacn::handler
@@ -0,0 +1,173 @@
+/**
+ * @file MergeReceiverPool.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "MergeReceiverPool.h"
+#include "mobilesacn/libmobilesacn/Metrics.h"
+#include <ranges>
+#include <spdlog/spdlog.h>
+
+namespace mobilesacn::handler {
+
+MergeReceiverPool *MergeReceiverPool::get()
+{
+    static MergeReceiverPool *instance = []() { return new MergeReceiverPool; }();
+    return instance;
+}
+
+MergeReceiverPool::MergeReceiverPool(QObject *parent) : QObject(parent)
+{
+    sweepTimer_.setInterval(kSweepInterval);
+    connect(&sweepTimer_, &QTimer::timeout, this, &MergeReceiverPool::sweep);
+}
+
+void MergeReceiverPool::startup(const Options &options)
+{
+    {
+        std::scoped_lock entriesLock(entriesMutex_);
+        options_ = options;
+        if (options_.prewarm) {
+            prewarmLocked(SourceDetector::get()->snapshot()->activeUniverses);
+        }
+    }
+    connect(
+        SourceDetector::get(),
+        &SourceDetector::sourceUpdated,
+        this,
+        &MergeReceiverPool::onSourceUpdated,
+        Qt::UniqueConnection);
+    sweepTimer_.start();
+}
+
+void MergeReceiverPool::shutdown()
+{
+    sweepTimer_.stop();
+    disconnect(SourceDetector::get(), nullptr, this, nullptr);
+
+    // Receivers still in use keep running until their subscribers let go.
+    std::vector<MergeReceiver::Ptr> stopped;
+    std::scoped_lock entriesLock(entriesMutex_);
+    for (auto &entry : entries_ | std::views::values) {
+        stopped.push_back(std::move(entry.receiver));
+    }
+    entries_.clear();
+    Metrics::get().sacnReceivers.set(0);
+}
+
+MergeReceiver::Ptr MergeReceiverPool::acquire(uint16_t universe)
+{
+    // Destroyed after unlocking, as stopping a receiver waits for the sACN thread.
+    std::vector<MergeReceiver::Ptr> evicted;
+    std::scoped_lock entriesLock(entriesMutex_);
+
+    auto it = entries_.find(universe);
+    if (it == entries_.end()) {
+        // Make room first.
+        evicted = evictLocked(options_.max_receivers > 0 ? options_.max_receivers - 1 : 0);
+        it = entries_.emplace(universe, Entry{.receiver = MergeReceiver::create(universe)}).first;
+        Metrics::get().sacnReceivers.set(static_cast<int64_t>(entries_.size()));
+    }
+    auto &entry = it->second;
+    entry.lastUsed = std::chrono::steady_clock::now();
+
+    auto subscribers = entry.subscribers.lock();
+    if (!subscribers) {
+        // Every subscriber shares this pointer, so the pool finds out when the last one leaves.
+        const auto receiver = entry.receiver;
+        subscribers = MergeReceiver::Ptr(
+            receiver.get(), [this, universe, receiver](MergeReceiver *) { release(universe); });
+        entry.subscribers = subscribers;
+    }
+    return subscribers;
+}
+
+void MergeReceiverPool::release(uint16_t universe)
+{
+    std::scoped_lock entriesLock(entriesMutex_);
+    const auto it = entries_.find(universe);
+    if (it != entries_.end()) {
+        SPDLOG_DEBUG("sACN Receiver for univ {} is idle", universe);
+        it->second.lastUsed = std::chrono::steady_clock::now();
+    }
+}
+
+std::vector<MergeReceiver::Ptr> MergeReceiverPool::evictLocked(std::size_t maxReceivers)
+{
+    std::vector<MergeReceiver::Ptr> evicted;
+    const auto now = std::chrono::steady_clock::now();
+
+    // Idle receivers that have lingered too long. Pre-warmed universes stay while they have
+    // sources.
+    const auto network = options_.prewarm ? SourceDetector::get()->snapshot() : nullptr;
+    std::erase_if(entries_, [&](auto &item) {
+        auto &[universe, entry] = item;
+        if (!entry.subscribers.expired() || now - entry.lastUsed < options_.linger) {
+            return false;
+        }
+        if (network && network->universeSources.contains(universe)) {
+            return false;
+        }
+        SPDLOG_DEBUG("Stopping idle sACN Receiver for univ {}", universe);
+        evicted.push_back(std::move(entry.receiver));
+        return true;
+    });
+
+    // Over budget, so stop the least recently used.
+    while (entries_.size() > maxReceivers) {
+        auto lru = entries_.end();
+        for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+            if (it->second.subscribers.expired()
+                && (lru == entries_.end() || it->second.lastUsed < lru->second.lastUsed)) {
+                lru = it;
+            }
+        }
+        if (lru == entries_.end()) {
+            // Everything is in use.
+            break;
+        }
+        SPDLOG_DEBUG("Stopping sACN Receiver for univ {} to stay within budget", lru->first);
+        evicted.push_back(std::move(lru->second.receiver));
+        entries_.erase(lru);
+    }
+
+    return evicted;
+}
+
+void MergeReceiverPool::prewarmLocked(const std::vector<uint16_t> &universes)
+{
+    const auto now = std::chrono::steady_clock::now();
+    for (const auto universe : universes) {
+        if (entries_.size() >= options_.max_receivers) {
+            break;
+        }
+        if (universe == 0 || entries_.contains(universe)) {
+            continue;
+        }
+        SPDLOG_DEBUG("Pre-warming sACN Receiver for univ {}", universe);
+        entries_.emplace(
+            universe, Entry{.receiver = MergeReceiver::create(universe), .lastUsed = now});
+    }
+    Metrics::get().sacnReceivers.set(static_cast<int64_t>(entries_.size()));
+}
+
+void MergeReceiverPool::sweep()
+{
+    std::vector<MergeReceiver::Ptr> evicted;
+    std::scoped_lock entriesLock(entriesMutex_);
+    evicted = evictLocked(options_.max_receivers);
+    Metrics::get().sacnReceivers.set(static_cast<int64_t>(entries_.size()));
+}
+
+void MergeReceiverPool::onSourceUpdated(const SourceDetectorSource &source)
+{
+    std::scoped_lock entriesLock(entriesMutex_);
+    if (options_.prewarm) {
+        prewarmLocked(source.universes);
+    }
+}
+
+} // namespace mobilesacn::handler
@@ -0,0 +1,96 @@
+/**
+ * @file MergeReceiverPool.h
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#ifndef MOBILESACN_LIBMOBILESACN_HANDLER_MERGERECEIVERPOOL_H
+#define MOBILESACN_LIBMOBILESACN_HANDLER_MERGERECEIVERPOOL_H
+
+#include "MergeReceiver.h"
+#include "SourceDetector.h"
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <QObject>
+#include <QTimer>
+
+namespace mobilesacn::handler {
+
+/**
+ * Shares MergeReceivers between subscribers, and keeps them running for a while once idle.
+ *
+ * The sACN library takes a sampling period to settle after a receiver starts, so keeping recently
+ * used receivers running makes switching back and forth between universes instant.
+ */
+class MergeReceiverPool : public QObject
+{
+    Q_OBJECT
+public:
+    struct Options
+    {
+        /** Keep a receiver running this long after its last subscriber leaves. */
+        std::chrono::milliseconds linger = std::chrono::seconds(30);
+        /**
+         * Most receivers to keep running. Idle receivers are stopped, least recently used first,
+         * to stay under this. Receivers in use are never stopped.
+         */
+        std::size_t max_receivers = 16;
+        /** Start receivers for universes the source detector finds, while under budget. */
+        bool prewarm = false;
+    };
+
+    static MergeReceiverPool *get();
+
+    MergeReceiverPool(const MergeReceiverPool &) = delete;
+    MergeReceiverPool &operator=(const MergeReceiverPool &) = delete;
+
+    void startup(const Options &options);
+    void shutdown();
+
+    /**
+     * Get the receiver for @p universe, starting it if needed.
+     *
+     * The receiver starts lingering once every returned pointer has been released.
+     */
+    MergeReceiver::Ptr acquire(uint16_t universe);
+
+private:
+    static constexpr auto kSweepInterval = std::chrono::seconds(1);
+
+    struct Entry
+    {
+        /** Keeps the receiver running while idle. */
+        MergeReceiver::Ptr receiver;
+        /** Pointer shared by every subscriber. Expired when the receiver is idle. */
+        std::weak_ptr<MergeReceiver> subscribers;
+        std::chrono::steady_clock::time_point lastUsed;
+    };
+
+    mutable std::mutex entriesMutex_;
+    Options options_;
+    std::unordered_map<uint16_t, Entry> entries_;
+    QTimer sweepTimer_;
+
+    explicit MergeReceiverPool(QObject *parent = nullptr);
+
+    void release(uint16_t universe);
+    /**
+     * Remove idle receivers that have lingered too long, then the least recently used idle
+     * receivers until at most @p maxReceivers remain.
+     *
+     * @return The removed receivers, so they can be destroyed after unlocking.
+     */
+    std::vector<MergeReceiver::Ptr> evictLocked(std::size_t maxReceivers);
+    void prewarmLocked(const std::vector<uint16_t> &universes);
+    void sweep();
+    void onSourceUpdated(const SourceDetectorSource &source);
+};
+
+} // namespace mobilesacn::handler
+
+#endif //MOBILESACN_LIBMOBILESACN_HANDLER_MERGERECEIVERPOOL_H
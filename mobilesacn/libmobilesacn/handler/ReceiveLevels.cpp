@@ -7,19 +7,30 @@
  */
 
 #include "ReceiveLevels.h"
+#include "SequenceMonitor.h"
+#include "SnapshotStore.h"
+#include "mobilesacn/libmobilesacn/Trace.h"
 #include "mobilesacn/libmobilesacn/util.h"
 #include "mobilesacn_messages/LevelBuffer.h"
-#include "mobilesacn_messages/ReceiveLevelsReq.h"
 #include "mobilesacn_messages/ReceiveLevelsResp.h"
+#include <algorithm>
 #include <mutex>
 #include <ranges>
 #include <spdlog/spdlog.h>
 
 namespace mobilesacn::handler {
 
-ReceiveLevels::ReceiveLevels(QWebSocket *ws, QObject *parent) : BaseHandler(ws, parent)
+ReceiveLevels::ReceiveLevels(QWebSocket *ws, QObject *parent) :
+    BaseHandler(ws, parent),
+    sourceLevelsTimer_(new QTimer(this)),
+    sequenceStatsTimer_(new QTimer(this))
 {
     connect(ws, &QWebSocket::binaryMessageReceived, this, &ReceiveLevels::onBinaryMessage);
+    sourceLevelsTimer_->setInterval(kMessageInterval);
+    connect(sourceLevelsTimer_, &QTimer::timeout, this, &ReceiveLevels::sendSourceLevels);
+    sequenceStatsTimer_->setInterval(kSequenceStatsInterval);
+    connect(sequenceStatsTimer_, &QTimer::timeout, this, &ReceiveLevels::sendSequenceStats);
+    sequenceStatsTimer_->start();
 
     // Send the current timestamp so the client can calibrate its offset relative to the server.
     flatbuffers::FlatBufferBuilder builder;
@@ -28,7 +39,7 @@ ReceiveLevels::ReceiveLevels(QWebSocket *ws, QObject *parent) : BaseHandler(ws,
     auto msgReceiveLevelsResp = message::CreateReceiveLevelsResp(
         builder, now, message::ReceiveLevelsRespVal::systemTime, msgSystemTime.Union());
     builder.Finish(msgReceiveLevelsResp);
-    sendBinaryMessage(builder.GetBufferPointer(), builder.GetSize());
+    queueMessage(builder);
 
     connect(
         SourceDetector::get(),
@@ -41,16 +52,63 @@ ReceiveLevels::ReceiveLevels(QWebSocket *ws, QObject *parent) : BaseHandler(ws,
         this,
         &ReceiveLevels::onSourceExpired);
     // Send known sources.
-    for (const auto &source : SourceDetector::get()->sources() | std::views::values) {
+    const auto sources = SourceDetector::get()->sources();
+    for (const auto &source : *sources | std::views::values) {
         onSourceUpdated(source);
     }
 }
 
+void ReceiveLevels::queueMessage(const flatbuffers::FlatBufferBuilder &builder)
+{
+    if (batch_.empty()) {
+        // Send everything queued during this event loop iteration together.
+        QMetaObject::invokeMethod(this, &ReceiveLevels::flushBatch, Qt::QueuedConnection);
+    }
+    batch_.emplace_back(
+        reinterpret_cast<const char *>(builder.GetBufferPointer()),
+        static_cast<qsizetype>(builder.GetSize()));
+}
+
+void ReceiveLevels::flushBatch()
+{
+    if (batch_.empty()) {
+        return;
+    }
+    if (batch_.size() == 1) {
+        sendBinaryMessage(batch_.front());
+        batch_.clear();
+        return;
+    }
+
+    flatbuffers::FlatBufferBuilder builder;
+    std::vector<flatbuffers::Offset<message::BatchItem>> msgItems;
+    msgItems.reserve(batch_.size());
+    for (const auto &payload : batch_) {
+        // Nested buffers must be aligned like a root buffer.
+        builder.ForceVectorAlignment(payload.size(), sizeof(uint8_t), alignof(uint64_t));
+        const auto msgPayload = builder.CreateVector(
+            reinterpret_cast<const uint8_t *>(payload.data()), payload.size());
+        msgItems.push_back(message::CreateBatchItem(builder, msgPayload));
+    }
+    batch_.clear();
+    const auto msgBatch = message::CreateBatch(builder, builder.CreateVector(msgItems));
+    const auto msgReceiveLevelsResp = message::CreateReceiveLevelsResp(
+        builder, getNowInMilliseconds(), message::ReceiveLevelsRespVal::batch, msgBatch.Union());
+    builder.Finish(msgReceiveLevelsResp);
+    sendBinaryMessage(builder.GetBufferPointer(), builder.GetSize());
+}
+
 void ReceiveLevels::onChangeUniverse(uint16_t universe)
 {
     std::scoped_lock lastSeenLock(lastSeenMutex_);
+    if (receiver_) {
+        // The old receiver may keep running for other clients or in the pool.
+        receiver_->disconnect(this);
+    }
     if (universe > 0) {
         receiver_ = MergeReceiver::getForUniverse(universe);
+        universeLatency_ = &LatencyTracker::get().forUniverse(universe);
+        universeMetrics_ = &Metrics::get().forUniverse(universe);
         connect(
             receiver_.get(),
             &MergeReceiver::sourceUpdated,
@@ -58,16 +116,31 @@ void ReceiveLevels::onChangeUniverse(uint16_t universe)
             qOverload<const sacn::MergeReceiver::Source &>(&ReceiveLevels::onSourceUpdated));
         connect(receiver_.get(), &MergeReceiver::dataChanged, this, &ReceiveLevels::onMergedData);
         connect(receiver_.get(), &MergeReceiver::sourceLost, this, &ReceiveLevels::onSourceLost);
+        if (auto frame = receiver_->lastFrame()) {
+            // The receiver was already running, so show its levels without waiting for a frame.
+            QMetaObject::invokeMethod(
+                this,
+                [this, frame]() {
+                    // Not a live frame, so it must not count toward latency.
+                    sendFrame(*frame, std::nullopt);
+                },
+                Qt::QueuedConnection);
+        }
         // Send known sources.
-        for (const auto &source : receiver_->sources() | std::views::values) {
+        const auto sources = receiver_->sources();
+        for (const auto &source : *sources | std::views::values) {
             onSourceUpdated(source);
         }
     } else {
         receiver_.reset();
+        universeLatency_ = nullptr;
+        universeMetrics_ = nullptr;
     }
     lastSeen_.levels.fill(0);
     lastSeen_.priorities.fill(0);
     lastSeen_.owners.fill({});
+    alertRules_.rearm();
+    updateSourceTap();
 }
 
 void ReceiveLevels::onChangeFlickerFinder(bool flickerFinder)
@@ -82,16 +155,532 @@ void ReceiveLevels::onChangeFlickerFinder(bool flickerFinder)
 
 void ReceiveLevels::onBinaryMessage(const QByteArray &data)
 {
+    flatbuffers::Verifier verifier(
+        reinterpret_cast<const uint8_t *>(data.data()), static_cast<std::size_t>(data.size()));
+    if (!message::VerifyReceiveLevelsReqBuffer(verifier)) {
+        SPDLOG_WARN("Dropping malformed ReceiveLevels message");
+        return;
+    }
     auto msg = message::GetReceiveLevelsReq(data.data());
     if (msg->val_type() == message::ReceiveLevelsReqVal::universe) {
         onChangeUniverse(msg->val_as_universe()->universe());
     } else if (msg->val_type() == message::ReceiveLevelsReqVal::flicker_finder) {
         onChangeFlickerFinder(msg->val_as_flicker_finder()->flickerFinder());
+    } else if (msg->val_type() == message::ReceiveLevelsReqVal::field_mask) {
+        onChangeFields(msg->val_as_field_mask()->fields());
+    } else if (msg->val_type() == message::ReceiveLevelsReqVal::address_windows) {
+        onChangeAddressWindows(*msg->val_as_address_windows());
+    } else if (msg->val_type() == message::ReceiveLevelsReqVal::source_selection) {
+        onChangeSourceSelection(*msg->val_as_source_selection());
+    } else if (msg->val_type() == message::ReceiveLevelsReqVal::what_if) {
+        onChangeWhatIf(*msg->val_as_what_if());
+    } else if (msg->val_type() == message::ReceiveLevelsReqVal::contention_finder) {
+        onChangeContentionFinder(msg->val_as_contention_finder()->contentionFinder());
+    } else if (msg->val_type() == message::ReceiveLevelsReqVal::journal_query) {
+        onJournalQuery(*msg->val_as_journal_query());
+    } else if (msg->val_type() == message::ReceiveLevelsReqVal::alert_rules) {
+        onChangeAlertRules(*msg->val_as_alert_rules());
+    } else if (msg->val_type() == message::ReceiveLevelsReqVal::snapshot) {
+        onSnapshot(*msg->val_as_snapshot());
+    }
+}
+
+void ReceiveLevels::onChangeFields(message::LevelsField fields)
+{
+    const bool hadSources = wants(message::LevelsField::Sources);
+    {
+        std::scoped_lock lastSeenLock(lastSeenMutex_);
+        fields_ = fields;
+    }
+    if (!hadSources && wants(message::LevelsField::Sources)) {
+        // Updates were skipped while unsubscribed, so send everything known now.
+        const auto sources = SourceDetector::get()->sources();
+        for (const auto &source : *sources | std::views::values) {
+            onSourceUpdated(source);
+        }
+        if (receiver_) {
+            const auto receiverSources = receiver_->sources();
+            for (const auto &source : *receiverSources | std::views::values) {
+                onSourceUpdated(source);
+            }
+        }
+    }
+}
+
+void ReceiveLevels::onChangeAddressWindows(const message::AddressWindows &msg)
+{
+    std::vector<AddressWindow> windows;
+    if (msg.ranges() != nullptr) {
+        for (const auto range : *msg.ranges()) {
+            if (windows.size() == kMaxAddressWindows) {
+                break;
+            }
+            windows.push_back({.start = range->start(), .count = range->count()});
+        }
+    }
+
+    std::scoped_lock lastSeenLock(lastSeenMutex_);
+    windows_ = normalizeWindows(std::move(windows));
+
+    // Fill in the new view right away instead of waiting for the next frame.
+    if (receiver_ && !flickerFinder_ && (fields_ & kFrameFields) != message::LevelsField::NONE) {
+        flatbuffers::FlatBufferBuilder builder;
+        buildLevelsChanged(
+            builder, lastSeen_, getNowInMilliseconds(), flatbuffers::nullopt, fields_, windows_);
+        flushBatch();
+        sendBinaryMessage(builder.GetBufferPointer(), builder.GetSize());
+    }
+}
+
+void ReceiveLevels::onChangeSourceSelection(const message::SourceSelection &msg)
+{
+    selectedSources_.clear();
+    if (msg.cids() != nullptr) {
+        for (const auto cid : *msg.cids()) {
+            if (selectedSources_.size() == kMaxSelectedSources) {
+                break;
+            }
+            const auto uuid = etcpal::Uuid::FromString(cid->str());
+            if (!uuid.IsNull()) {
+                selectedSources_.insert(uuid);
+            }
+        }
+    }
+    updateSourceTap();
+}
+
+void ReceiveLevels::onChangeWhatIf(const message::WhatIf &msg)
+{
+    if (msg.priorities() == nullptr || msg.priorities()->size() == 0) {
+        whatIfPriorities_.reset();
+    } else {
+        whatIfPriorities_.emplace();
+        for (const auto priority : *msg.priorities()) {
+            if (whatIfPriorities_->size() == LocalMerger::kMaxSources) {
+                break;
+            }
+            const auto uuid = etcpal::Uuid::FromString(priority->cid()->str());
+            if (!uuid.IsNull()) {
+                (*whatIfPriorities_)[uuid] = priority->priority();
+            }
+        }
     }
+    whatIfChanged_ = true;
+    updateSourceTap();
 }
 
-void ReceiveLevels::onSourceUpdated(const SourceDetectorSource &source) const
+void ReceiveLevels::onChangeContentionFinder(bool contentionFinder)
 {
+    contentionFinder_ = contentionFinder;
+    lastContention_.reset();
+    updateSourceTap();
+}
+
+void ReceiveLevels::onJournalQuery(const message::JournalQuery &msg)
+{
+    MSACN_TRACE_SPAN("onJournalQuery");
+    if (!receiver_) {
+        return;
+    }
+    // The journal keeps steady clock times so changing the system clock does not reorder it.
+    const auto steadyNow = ChangeJournal::Clock::now();
+    const auto now = static_cast<int64_t>(getNowInMilliseconds());
+    const auto toSteady = [steadyNow, now](uint64_t timestamp) {
+        return steadyNow - std::chrono::milliseconds(now - static_cast<int64_t>(timestamp));
+    };
+    ChangeJournal::Query query;
+    if (msg.address().has_value()) {
+        query.address = msg.address().value();
+    }
+    query.from = toSteady(msg.from());
+    if (msg.to() != 0) {
+        query.to = toSteady(msg.to());
+    }
+    query.limit = std::min(static_cast<std::size_t>(msg.limit()), kMaxJournalChanges);
+    const auto changes = receiver_->journal().query(query);
+
+    flatbuffers::FlatBufferBuilder builder;
+    // Each owner is only sent once.
+    std::unordered_map<std::string, uint16_t> ownerIds;
+    std::vector<flatbuffers::Offset<flatbuffers::String>> msgOwners;
+    std::vector<message::JournalChange> msgChanges;
+    msgChanges.reserve(changes.size());
+    for (const auto &change : changes) {
+        auto [owner, inserted] = ownerIds.try_emplace(
+            change.owner, static_cast<uint16_t>(msgOwners.size()));
+        if (inserted) {
+            msgOwners.push_back(builder.CreateString(change.owner));
+        }
+        const auto age = std::chrono::duration_cast<std::chrono::milliseconds>(
+            steadyNow - change.time);
+        msgChanges.emplace_back(
+            now - age.count(), change.address, change.oldLevel, change.newLevel, owner->second);
+    }
+    const auto msgChangesVec = builder.CreateVectorOfStructs(msgChanges);
+    const auto msgOwnersVec = builder.CreateVector(msgOwners);
+    const auto msgJournal = message::CreateJournal(builder, msgChangesVec, msgOwnersVec);
+    const auto msgReceiveLevelsResp = message::CreateReceiveLevelsResp(
+        builder,
+        getNowInMilliseconds(),
+        message::ReceiveLevelsRespVal::journal,
+        msgJournal.Union());
+    builder.Finish(msgReceiveLevelsResp);
+    queueMessage(builder);
+}
+
+void ReceiveLevels::onChangeAlertRules(const message::AlertRules &msg)
+{
+    std::vector<AlertRules::Rule> rules;
+    if (msg.rules() != nullptr) {
+        for (const auto rule : *msg.rules()) {
+            if (rules.size() == kMaxAlertRules) {
+                break;
+            }
+            rules.push_back({
+                .id = rule->id(),
+                .kind = static_cast<AlertRules::Kind>(rule->kind()),
+                .start = rule->start(),
+                .count = rule->count(),
+                .level = rule->level(),
+                .sources = rule->sources(),
+            });
+        }
+    }
+    alertRules_.setRules(rules);
+}
+
+void ReceiveLevels::sendAlerts(const MergedFrame &frame)
+{
+    std::vector<AlertRules::Event> events;
+    alertRules_.evaluate(frame.levels, receiver_->sources()->size(), events);
+    if (events.empty()) {
+        return;
+    }
+
+    flatbuffers::FlatBufferBuilder builder;
+    std::vector<flatbuffers::Offset<message::AlertEvent>> msgEvents;
+    msgEvents.reserve(events.size());
+    for (const auto &event : events) {
+        msgEvents.push_back(message::CreateAlertEvent(
+            builder,
+            event.id,
+            event.active,
+            event.address ? flatbuffers::Optional<uint16_t>(*event.address) : flatbuffers::nullopt,
+            event.level));
+    }
+    const auto msgEventsVec = builder.CreateVector(msgEvents);
+    const auto msgAlerts = message::CreateAlerts(builder, msgEventsVec);
+    const auto msgReceiveLevelsResp = message::CreateReceiveLevelsResp(
+        builder,
+        getNowInMilliseconds(),
+        message::ReceiveLevelsRespVal::alerts,
+        msgAlerts.Union(),
+        frame.arrivalTimestamp);
+    builder.Finish(msgReceiveLevelsResp);
+    queueMessage(builder);
+}
+
+void ReceiveLevels::onSnapshot(const message::SnapshotReq &msg)
+{
+    const auto name = msg.name() != nullptr ? msg.name()->str() : std::string();
+    auto *store = SnapshotStore::get();
+    if (msg.action() == message::SnapshotAction::Save) {
+        const auto frame = receiver_ ? receiver_->lastFrame() : nullptr;
+        if (!frame || !store->save(UniverseSnapshot::capture(name, *frame))) {
+            SPDLOG_WARN("Could not save snapshot \"{}\"", name);
+        }
+    } else if (msg.action() == message::SnapshotAction::Delete) {
+        store->remove(name);
+    } else if (msg.action() == message::SnapshotAction::Diff) {
+        const auto other = msg.other() != nullptr ? std::make_optional(msg.other()->str())
+                                                  : std::nullopt;
+        if (sendSnapshotDiff(name, other)) {
+            return;
+        }
+    }
+    sendSnapshotList();
+}
+
+void ReceiveLevels::sendSnapshotList()
+{
+    flatbuffers::FlatBufferBuilder builder;
+    std::vector<flatbuffers::Offset<message::SnapshotInfo>> msgSnapshots;
+    for (const auto &snapshot : SnapshotStore::get()->list()) {
+        const auto msgName = builder.CreateString(snapshot->name);
+        msgSnapshots.push_back(message::CreateSnapshotInfo(
+            builder, msgName, snapshot->universe, snapshot->timestamp));
+    }
+    const auto msgSnapshotsVec = builder.CreateVector(msgSnapshots);
+    const auto msgSnapshotList = message::CreateSnapshotList(builder, msgSnapshotsVec);
+    const auto msgReceiveLevelsResp = message::CreateReceiveLevelsResp(
+        builder,
+        getNowInMilliseconds(),
+        message::ReceiveLevelsRespVal::snapshotList,
+        msgSnapshotList.Union());
+    builder.Finish(msgReceiveLevelsResp);
+    queueMessage(builder);
+}
+
+bool ReceiveLevels::sendSnapshotDiff(
+    const std::string &name, const std::optional<std::string> &other)
+{
+    MSACN_TRACE_SPAN("sendSnapshotDiff");
+    flatbuffers::FlatBufferBuilder builder;
+    const auto send = [this, &builder, &name, &other](
+                          message::SnapshotDiffStatus status,
+                          const std::vector<flatbuffers::Offset<message::SnapshotDiffRun>> &runs,
+                          uint16_t universe,
+                          uint16_t otherUniverse) {
+        const auto msgName = builder.CreateString(name);
+        flatbuffers::Offset<flatbuffers::String> msgOther;
+        if (other) {
+            msgOther = builder.CreateString(*other);
+        }
+        const auto msgRunsVec = builder.CreateVector(runs);
+        const auto msgSnapshotDiff = message::CreateSnapshotDiff(
+            builder, msgName, msgOther, msgRunsVec, universe, otherUniverse, status);
+        const auto msgReceiveLevelsResp = message::CreateReceiveLevelsResp(
+            builder,
+            getNowInMilliseconds(),
+            message::ReceiveLevelsRespVal::snapshotDiff,
+            msgSnapshotDiff.Union());
+        builder.Finish(msgReceiveLevelsResp);
+        queueMessage(builder);
+        return status != message::SnapshotDiffStatus::NotFound;
+    };
+
+    const auto snapshot = SnapshotStore::get()->find(name);
+    if (!snapshot) {
+        return send(message::SnapshotDiffStatus::NotFound, {}, 0, 0);
+    }
+    // Keep whichever is compared alive until the message is built.
+    UniverseSnapshot::Ptr otherSnapshot;
+    MergedFrame::Ptr frame;
+    const UniverseSnapshot::Buffer *otherLevels;
+    const UniverseSnapshot::Buffer *otherPriorities;
+    if (other) {
+        otherSnapshot = SnapshotStore::get()->find(*other);
+        if (!otherSnapshot) {
+            return send(message::SnapshotDiffStatus::NotFound, {}, snapshot->universe, 0);
+        }
+        otherLevels = &otherSnapshot->levels;
+        otherPriorities = &otherSnapshot->priorities;
+    } else {
+        if (snapshot->universe == 0) {
+            return send(message::SnapshotDiffStatus::NoLevels, {}, 0, 0);
+        }
+        // Compare with the snapshot's universe, which need not be the one this client receives.
+        // A receiver started here lingers in the pool, so asking again once it has levels works.
+        const auto receiver = receiver_ && receiver_->universe() == snapshot->universe
+                                  ? receiver_
+                                  : MergeReceiver::getForUniverse(snapshot->universe);
+        frame = receiver->lastFrame();
+        if (!frame) {
+            return send(
+                message::SnapshotDiffStatus::NoLevels, {}, snapshot->universe, snapshot->universe);
+        }
+        otherLevels = &frame->levels;
+        otherPriorities = &frame->priorities;
+    }
+    const auto runs = SnapshotStore::diff(
+        snapshot->levels, snapshot->priorities, *otherLevels, *otherPriorities);
+
+    std::vector<flatbuffers::Offset<message::SnapshotDiffRun>> msgRuns;
+    msgRuns.reserve(runs.size());
+    for (const auto &run : runs) {
+        const auto slice = [&builder, &run](const UniverseSnapshot::Buffer &buffer) {
+            return builder.CreateVector(buffer.data() + run.start, run.count);
+        };
+        const auto msgLevels = slice(snapshot->levels);
+        const auto msgPriorities = slice(snapshot->priorities);
+        const auto msgOtherLevels = slice(*otherLevels);
+        const auto msgOtherPriorities = slice(*otherPriorities);
+        msgRuns.push_back(message::CreateSnapshotDiffRun(
+            builder,
+            run.start,
+            msgLevels,
+            msgPriorities,
+            msgOtherLevels,
+            msgOtherPriorities));
+    }
+    return send(
+        message::SnapshotDiffStatus::Ok,
+        msgRuns,
+        snapshot->universe,
+        otherSnapshot ? otherSnapshot->universe : snapshot->universe);
+}
+
+void ReceiveLevels::updateSourceTap()
+{
+    const uint16_t universe = receiver_ ? receiver_->universe() : 0;
+    if (universe == 0 || (selectedSources_.empty() && !whatIfPriorities_ && !contentionFinder_)) {
+        sourceLevelsTimer_->stop();
+        sourceTap_.reset();
+        sources_.clear();
+        return;
+    }
+    if (!sourceTap_ || sourceTap_->universe() != universe) {
+        sourceTap_ = SourceTap::getForUniverse(universe);
+        sources_.clear();
+        lastContention_.reset();
+        whatIfChanged_ = true;
+    }
+    // Send everything on the next tick, as the client has nothing for newly selected sources.
+    sentSourceVersions_.clear();
+    sourceLevelsTimer_->start();
+}
+
+void ReceiveLevels::sendSourceLevels()
+{
+    MSACN_TRACE_SPAN("sendSourceLevels");
+    if (!sourceTap_) {
+        return;
+    }
+    const auto generation = sourceTap_->copySources(sources_);
+    if (contentionFinder_ && (!lastContention_ || generation != contentionGeneration_)) {
+        contentionGeneration_ = generation;
+        sendContention();
+    }
+    constexpr auto kSourceFields = message::LevelsField::Levels | message::LevelsField::Priorities;
+    if ((fields_ & kSourceFields) == message::LevelsField::NONE) {
+        // Leave the changes for when the client asks for levels again.
+        return;
+    }
+    // Sources that stopped are sent again if they come back.
+    std::erase_if(sentSourceVersions_, [this](const auto &item) {
+        return !sources_.contains(item.first);
+    });
+    for (const auto &cid : selectedSources_) {
+        const auto source = sources_.find(cid);
+        if (source == sources_.cend()) {
+            continue;
+        }
+        const auto sent = sentSourceVersions_.find(cid);
+        if (sent != sentSourceVersions_.cend() && sent->second == source->second.version) {
+            continue;
+        }
+        sentSourceVersions_[cid] = source->second.version;
+        flatbuffers::FlatBufferBuilder builder;
+        buildSourceLevels(
+            builder, cid.ToString(), source->second, getNowInMilliseconds(), fields_, windows_);
+        queueMessage(builder);
+    }
+
+    if (whatIfPriorities_ && (whatIfChanged_ || generation != whatIfGeneration_)) {
+        whatIfChanged_ = false;
+        whatIfGeneration_ = generation;
+        sendWhatIfLevels();
+    }
+}
+
+void ReceiveLevels::sendWhatIfLevels()
+{
+    MSACN_TRACE_SPAN("sendWhatIfLevels");
+    std::vector<LocalMerger::Input> inputs;
+    std::vector<std::string> cids;
+    for (const auto &[cid, source] : sources_) {
+        if (inputs.size() == LocalMerger::kMaxSources) {
+            break;
+        }
+        const auto priority = whatIfPriorities_->find(cid);
+        inputs.push_back(LocalMerger::Input{
+            .levels = &source.levels,
+            .priorities = &source.priorities,
+            .priorityOverride = priority != whatIfPriorities_->cend()
+                                    ? std::make_optional(priority->second)
+                                    : std::nullopt,
+        });
+        cids.push_back(cid.ToString());
+    }
+    LocalMerger::Result merged;
+    LocalMerger::merge(inputs, merged);
+
+    std::array<std::string, kSacnDmxAddressCount> owners{};
+    const bool hasOwners = wants(message::LevelsField::Owners);
+    if (hasOwners) {
+        for (std::size_t address = 0; address < owners.size(); ++address) {
+            if (merged.owners[address] != LocalMerger::kNoOwner) {
+                owners[address] = cids[merged.owners[address]];
+            }
+        }
+    }
+    flatbuffers::FlatBufferBuilder builder;
+    buildWhatIfLevels(
+        builder,
+        merged,
+        hasOwners ? &owners : nullptr,
+        getNowInMilliseconds(),
+        fields_,
+        windows_);
+    queueMessage(builder);
+}
+
+void ReceiveLevels::sendContention()
+{
+    MSACN_TRACE_SPAN("sendContention");
+    std::vector<ContentionMap::Input> inputs;
+    for (const auto &source : sources_ | std::views::values) {
+        if (inputs.size() == ContentionMap::kMaxSources) {
+            break;
+        }
+        inputs.push_back({.levels = &source.levels, .priorities = &source.priorities});
+    }
+    ContentionMap::Result contention;
+    ContentionMap::compute(inputs, contention);
+    if (contention == lastContention_) {
+        return;
+    }
+    lastContention_ = contention;
+
+    flatbuffers::FlatBufferBuilder builder;
+    const auto msgCounts
+        = builder.CreateVector(contention.counts.data(), contention.counts.size());
+    const auto msgHtp = builder.CreateVector(contention.htp.data(), contention.htp.size());
+    const auto msgContention = message::CreateContention(builder, msgCounts, msgHtp);
+    const auto msgReceiveLevelsResp = message::CreateReceiveLevelsResp(
+        builder,
+        getNowInMilliseconds(),
+        message::ReceiveLevelsRespVal::contention,
+        msgContention.Union());
+    builder.Finish(msgReceiveLevelsResp);
+    queueMessage(builder);
+}
+
+void ReceiveLevels::sendSequenceStats()
+{
+    if (!receiver_ || !wants(message::LevelsField::Sources)) {
+        return;
+    }
+    const auto stats = SequenceMonitor::get()->statsForUniverse(receiver_->universe());
+    flatbuffers::FlatBufferBuilder builder;
+    std::vector<flatbuffers::Offset<message::SourceSequenceStats>> msgSources;
+    msgSources.reserve(stats.size());
+    for (const auto &[cid, sourceStats] : stats) {
+        const auto msgCid = builder.CreateString(cid.ToString());
+        msgSources.push_back(message::CreateSourceSequenceStats(
+            builder,
+            msgCid,
+            sourceStats.received,
+            sourceStats.lost,
+            sourceStats.duplicated,
+            sourceStats.outOfOrder));
+    }
+    const auto msgSourcesVec = builder.CreateVector(msgSources);
+    const auto msgSequenceStats = message::CreateSequenceStats(builder, msgSourcesVec);
+    const auto msgReceiveLevelsResp = message::CreateReceiveLevelsResp(
+        builder,
+        getNowInMilliseconds(),
+        message::ReceiveLevelsRespVal::sequenceStats,
+        msgSequenceStats.Union());
+    builder.Finish(msgReceiveLevelsResp);
+    queueMessage(builder);
+}
+
+void ReceiveLevels::onSourceUpdated(const SourceDetectorSource &source)
+{
+    if (!wants(message::LevelsField::Sources)) {
+        return;
+    }
     flatbuffers::FlatBufferBuilder builder;
     const auto msgCid = builder.CreateString(source.cid);
     const auto msgName = builder.CreateString(source.name);
@@ -107,11 +696,14 @@ void ReceiveLevels::onSourceUpdated(const SourceDetectorSource &source) const
         message::ReceiveLevelsRespVal::sourceUpdated,
         msgSourceUpdated.Union());
     builder.Finish(msgReceiveLevelsResp);
-    sendBinaryMessage(builder.GetBufferPointer(), builder.GetSize());
+    queueMessage(builder);
 }
 
-void ReceiveLevels::onSourceUpdated(const sacn::MergeReceiver::Source &source) const
+void ReceiveLevels::onSourceUpdated(const sacn::MergeReceiver::Source &source)
 {
+    if (!wants(message::LevelsField::Sources)) {
+        return;
+    }
     flatbuffers::FlatBufferBuilder builder;
     const auto msgCid = builder.CreateString(source.cid.ToString());
     const auto msgName = builder.CreateString(source.name);
@@ -129,15 +721,37 @@ void ReceiveLevels::onSourceUpdated(const sacn::MergeReceiver::Source &source) c
         message::ReceiveLevelsRespVal::sourceUpdated,
         msgSourceUpdated.Union());
     builder.Finish(msgReceiveLevelsResp);
-    sendBinaryMessage(builder.GetBufferPointer(), builder.GetSize());
+    queueMessage(builder);
 }
 
-void ReceiveLevels::onMergedData(
-    const SacnRecvMergedData &mergedData, const std::array<std::string, 512> &ownerCids)
+void ReceiveLevels::onMergedData(const MergedFrame::Ptr &frame)
 {
+    const auto handlerStart = std::chrono::steady_clock::now();
+    Tracer::get().record("Queue wait", frame->arrival, handlerStart);
+    if (!receiver_ || receiver_->universe() != frame->universe) {
+        // Frame was queued before the universe changed.
+        return;
+    }
+    latency().queue.record(handlerStart - frame->arrival);
+    universeLatency_->queue.record(handlerStart - frame->arrival);
+    if (!alertRules_.empty()) {
+        // Checked on every frame, even those dropped below.
+        sendAlerts(*frame);
+    }
+    sendFrame(*frame, handlerStart);
+}
+
+void ReceiveLevels::sendFrame(
+    const MergedFrame &frame,
+    const std::optional<std::chrono::steady_clock::time_point> handlerStart)
+{
+    if (!receiver_ || receiver_->universe() != frame.universe) {
+        // Queued from the previous receiver, so it must not be drawn over the new universe.
+        return;
+    }
     std::unique_lock<decltype(lastSeenMutex_)> lastSeenLock;
-    if (flickerFinder_) {
-        // Block for the lock, as we don't want to miss frames in flicker finder.
+    if (flickerFinder_ || !handlerStart) {
+        // Block for the lock, as we don't want to miss frames in flicker finder or the replay.
         lastSeenLock = std::unique_lock(lastSeenMutex_);
     } else {
         // If we can't get the lock, we will try again on the next frame.
@@ -145,79 +759,264 @@ void ReceiveLevels::onMergedData(
     }
     if (!lastSeenLock) {
         SPDLOG_DEBUG("Could not lock last seen buffers.");
+        universeMetrics_->framesDropped.add();
         return;
     }
 
-    // Determine where in addresses 1-512 our received data is.
-    const auto bufOffset = mergedData.slot_range.start_address - 1;
-    const auto bufCount
-        = std::min(mergedData.slot_range.address_count, static_cast<int>(kSacnDmxAddressCount));
+    const auto send = [this, &frame, handlerStart](const flatbuffers::FlatBufferBuilder &builder) {
+        // Keep messages in order.
+        flushBatch();
+        if (!handlerStart) {
+            sendBinaryMessage(builder.GetBufferPointer(), builder.GetSize());
+            return;
+        }
+        const auto encoded = std::chrono::steady_clock::now();
+        Tracer::get().record("Encode", *handlerStart, encoded);
+        latency().encode.record(encoded - *handlerStart);
+        universeLatency_->encode.record(encoded - *handlerStart);
+        sendBinaryMessage(
+            builder.GetBufferPointer(),
+            builder.GetSize(),
+            FrameTiming{
+                .arrival = frame.arrival,
+                .encoded = encoded,
+                .universeLatency = universeLatency_,
+            });
+    };
 
     if (!flickerFinder_) {
         // Normal "display current levels" mode.
-        std::memcpy(lastSeen_.levels.data() + bufOffset, mergedData.levels, bufCount);
-        std::memcpy(lastSeen_.priorities.data() + bufOffset, mergedData.priorities, bufCount);
-        lastSeen_.owners = ownerCids;
+        lastSeen_.levels = frame.levels;
+        lastSeen_.priorities = frame.priorities;
+        if (wants(message::LevelsField::Owners)) {
+            // Copying 512 strings is costly, so only do it if they are sent.
+            lastSeen_.owners = frame.ownerCids;
+        }
 
+        if ((fields_ & kFrameFields) == message::LevelsField::NONE) {
+            return;
+        }
         flatbuffers::FlatBufferBuilder builder;
-
-        const auto msgLevels = message::LevelBuffer(lastSeen_.levels);
-        const auto msgPriorities = message::LevelBuffer(lastSeen_.priorities);
-        const auto msgOwners = builder.CreateVectorOfStrings(ownerCids.cbegin(), ownerCids.cend());
-
-        // Wrap the message.
-        auto levelsChangedBuilder = message::LevelsChangedBuilder(builder);
-        levelsChangedBuilder.add_levels(&msgLevels);
-        levelsChangedBuilder.add_priorities(&msgPriorities);
-        levelsChangedBuilder.add_owners(msgOwners);
-        const auto msgLevelsChanged = levelsChangedBuilder.Finish();
-
-        // Send the message.
-        const auto msgReceiveLevelsResp = message::CreateReceiveLevelsResp(
+        buildLevelsChanged(
             builder,
+            lastSeen_,
             getNowInMilliseconds(),
-            message::ReceiveLevelsRespVal::levelsChanged,
-            msgLevelsChanged.Union());
-        builder.Finish(msgReceiveLevelsResp);
-        sendBinaryMessage(builder.GetBufferPointer(), builder.GetSize());
+            frame.arrivalTimestamp,
+            fields_,
+            windows_);
+        send(builder);
     } else {
         // Flicker finder mode.
         std::scoped_lock flickerFinderLock(flickerFinderReferenceBufferMutex_);
-        decltype(lastSeen_.levels) levelsBuffer{};
-        std::memcpy(levelsBuffer.data() + bufOffset, mergedData.levels, bufCount);
-        // Compare new levels to levels stored in the buffer.
-        std::vector<message::LevelChange> levelChanges;
-        for (unsigned int address = 0; address < levelsBuffer.size(); ++address) {
-            const auto oldLevel = lastSeen_.levels[address];
-            const auto newLevel = levelsBuffer[address];
-            if (newLevel != oldLevel) {
-                // Found a flicker, add it to the list.
-                const auto diff = newLevel - flickerFinderReferenceBuffer_[address];
-                levelChanges.emplace_back(address, newLevel, diff);
-            }
-        }
-        if (!levelChanges.empty()) {
-            // Send flickers.
-            flatbuffers::FlatBufferBuilder builder;
-            const auto msgLevelChanges = builder.CreateVectorOfStructs(levelChanges);
-            const auto msgFlicker = message::CreateFlicker(builder, msgLevelChanges);
-            const auto msgReceiveLevelsResp = message::CreateReceiveLevelsResp(
+        flatbuffers::FlatBufferBuilder builder;
+        if (buildFlicker(
                 builder,
+                lastSeen_.levels,
+                frame.levels,
+                flickerFinderReferenceBuffer_,
                 getNowInMilliseconds(),
-                message::ReceiveLevelsRespVal::flicker,
-                msgFlicker.Union());
-            builder.Finish(msgReceiveLevelsResp);
-            sendBinaryMessage(builder.GetBufferPointer(), builder.GetSize());
+                frame.arrivalTimestamp)) {
+            // Send flickers.
+            send(builder);
         }
         // Now that we've made comparisons, it's safe to update last seen.
-        std::memcpy(lastSeen_.levels.data() + bufOffset, mergedData.levels, bufCount);
-        std::memcpy(lastSeen_.priorities.data() + bufOffset, mergedData.priorities, bufCount);
-        lastSeen_.owners = ownerCids;
+        lastSeen_.levels = frame.levels;
+        lastSeen_.priorities = frame.priorities;
+        lastSeen_.owners = frame.ownerCids;
     }
 }
 
-void ReceiveLevels::onSourceExpired(const std::string &cid) const
+void ReceiveLevels::buildLevelsChanged(
+    flatbuffers::FlatBufferBuilder &builder,
+    const LastSeen &lastSeen,
+    const uint64_t timestamp,
+    const flatbuffers::Optional<uint64_t> arrivalTimestamp,
+    const message::LevelsField fields,
+    const std::span<const AddressWindow> windows)
+{
+    const auto msgLevelsChanged = createLevelsChanged(
+        builder, lastSeen.levels, lastSeen.priorities, &lastSeen.owners, fields, windows);
+
+    // Wrap the message.
+    const auto msgReceiveLevelsResp = message::CreateReceiveLevelsResp(
+        builder,
+        timestamp,
+        message::ReceiveLevelsRespVal::levelsChanged,
+        msgLevelsChanged.Union(),
+        arrivalTimestamp);
+    builder.Finish(msgReceiveLevelsResp);
+}
+
+void ReceiveLevels::buildSourceLevels(
+    flatbuffers::FlatBufferBuilder &builder,
+    const std::string &cid,
+    const SourceTap::Source &source,
+    const uint64_t timestamp,
+    const message::LevelsField fields,
+    const std::span<const AddressWindow> windows)
+{
+    const auto msgLevelsChanged
+        = createLevelsChanged(builder, source.levels, source.priorities, nullptr, fields, windows);
+    const auto msgCid = builder.CreateString(cid);
+    const auto msgSourceLevels = message::CreateSourceLevels(builder, msgCid, msgLevelsChanged);
+
+    // Wrap the message.
+    const auto msgReceiveLevelsResp = message::CreateReceiveLevelsResp(
+        builder,
+        timestamp,
+        message::ReceiveLevelsRespVal::sourceLevels,
+        msgSourceLevels.Union(),
+        source.arrivalTimestamp);
+    builder.Finish(msgReceiveLevelsResp);
+}
+
+void ReceiveLevels::buildWhatIfLevels(
+    flatbuffers::FlatBufferBuilder &builder,
+    const LocalMerger::Result &merged,
+    const std::array<std::string, kSacnDmxAddressCount> *owners,
+    const uint64_t timestamp,
+    const message::LevelsField fields,
+    const std::span<const AddressWindow> windows)
+{
+    const auto msgLevelsChanged
+        = createLevelsChanged(builder, merged.levels, merged.priorities, owners, fields, windows);
+    const auto msgWhatIfLevels = message::CreateWhatIfLevels(builder, msgLevelsChanged);
+
+    // Wrap the message.
+    const auto msgReceiveLevelsResp = message::CreateReceiveLevelsResp(
+        builder, timestamp, message::ReceiveLevelsRespVal::whatIfLevels, msgWhatIfLevels.Union());
+    builder.Finish(msgReceiveLevelsResp);
+}
+
+flatbuffers::Offset<message::LevelsChanged> ReceiveLevels::createLevelsChanged(
+    flatbuffers::FlatBufferBuilder &builder,
+    const std::array<uint8_t, kSacnDmxAddressCount> &levels,
+    const std::array<uint8_t, kSacnDmxAddressCount> &priorities,
+    const std::array<std::string, kSacnDmxAddressCount> *owners,
+    const message::LevelsField fields,
+    const std::span<const AddressWindow> windows)
 {
+    const bool hasLevels = (fields & message::LevelsField::Levels) != message::LevelsField::NONE;
+    const bool hasPriorities
+        = (fields & message::LevelsField::Priorities) != message::LevelsField::NONE;
+    const bool hasOwners = owners != nullptr
+                           && (fields & message::LevelsField::Owners) != message::LevelsField::NONE;
+
+    if (!windows.empty()) {
+        // Only the addresses the client is viewing.
+        std::vector<flatbuffers::Offset<message::LevelSlice>> msgSlices;
+        msgSlices.reserve(windows.size());
+        for (const auto &window : windows) {
+            flatbuffers::Offset<flatbuffers::Vector<uint8_t>> msgLevels;
+            flatbuffers::Offset<flatbuffers::Vector<uint8_t>> msgPriorities;
+            flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>>
+                msgOwners;
+            if (hasLevels) {
+                msgLevels = builder.CreateVector(levels.data() + window.start, window.count);
+            }
+            if (hasPriorities) {
+                msgPriorities
+                    = builder.CreateVector(priorities.data() + window.start, window.count);
+            }
+            if (hasOwners) {
+                const auto ownersBegin = owners->cbegin() + window.start;
+                msgOwners = builder.CreateVectorOfStrings(ownersBegin, ownersBegin + window.count);
+            }
+            msgSlices.push_back(message::CreateLevelSlice(
+                builder, window.start, msgLevels, msgPriorities, msgOwners));
+        }
+        const auto msgSlicesVec = builder.CreateVector(msgSlices);
+        auto levelsChangedBuilder = message::LevelsChangedBuilder(builder);
+        levelsChangedBuilder.add_slices(msgSlicesVec);
+        return levelsChangedBuilder.Finish();
+    }
+
+    const auto msgLevels = message::LevelBuffer(levels);
+    const auto msgPriorities = message::LevelBuffer(priorities);
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> msgOwners;
+    if (hasOwners) {
+        msgOwners = builder.CreateVectorOfStrings(owners->cbegin(), owners->cend());
+    }
+
+    auto levelsChangedBuilder = message::LevelsChangedBuilder(builder);
+    if (hasLevels) {
+        levelsChangedBuilder.add_levels(&msgLevels);
+    }
+    if (hasPriorities) {
+        levelsChangedBuilder.add_priorities(&msgPriorities);
+    }
+    if (hasOwners) {
+        levelsChangedBuilder.add_owners(msgOwners);
+    }
+    return levelsChangedBuilder.Finish();
+}
+
+std::vector<ReceiveLevels::AddressWindow> ReceiveLevels::normalizeWindows(
+    std::vector<AddressWindow> windows)
+{
+    // Clamp to the universe.
+    constexpr std::size_t kAddressCount = kSacnDmxAddressCount;
+    for (auto &window : windows) {
+        window.start = std::min(window.start, kAddressCount);
+        window.count = std::min(window.count, kAddressCount - window.start);
+    }
+    std::erase_if(windows, [](const AddressWindow &window) { return window.count == 0; });
+
+    // Merge overlapping and adjacent windows.
+    std::ranges::sort(windows, {}, &AddressWindow::start);
+    std::vector<AddressWindow> merged;
+    for (const auto &window : windows) {
+        if (!merged.empty() && window.start <= merged.back().start + merged.back().count) {
+            auto &last = merged.back();
+            const auto end = std::max(last.start + last.count, window.start + window.count);
+            last.count = end - last.start;
+        } else {
+            merged.push_back(window);
+        }
+    }
+    return merged;
+}
+
+bool ReceiveLevels::buildFlicker(
+    flatbuffers::FlatBufferBuilder &builder,
+    const std::array<uint8_t, kSacnDmxAddressCount> &oldLevels,
+    const std::array<uint8_t, kSacnDmxAddressCount> &newLevels,
+    const std::array<uint8_t, kSacnDmxAddressCount> &referenceLevels,
+    const uint64_t timestamp,
+    const flatbuffers::Optional<uint64_t> arrivalTimestamp)
+{
+    // Compare new levels to levels stored in the buffer.
+    std::vector<message::LevelChange> levelChanges;
+    for (unsigned int address = 0; address < newLevels.size(); ++address) {
+        const auto oldLevel = oldLevels[address];
+        const auto newLevel = newLevels[address];
+        if (newLevel != oldLevel) {
+            // Found a flicker, add it to the list.
+            const auto diff = newLevel - referenceLevels[address];
+            levelChanges.emplace_back(address, newLevel, diff);
+        }
+    }
+    if (levelChanges.empty()) {
+        return false;
+    }
+
+    const auto msgLevelChanges = builder.CreateVectorOfStructs(levelChanges);
+    const auto msgFlicker = message::CreateFlicker(builder, msgLevelChanges);
+    const auto msgReceiveLevelsResp = message::CreateReceiveLevelsResp(
+        builder,
+        timestamp,
+        message::ReceiveLevelsRespVal::flicker,
+        msgFlicker.Union(),
+        arrivalTimestamp);
+    builder.Finish(msgReceiveLevelsResp);
+    return true;
+}
+
+void ReceiveLevels::onSourceExpired(const std::string &cid)
+{
+    if (!wants(message::LevelsField::Sources)) {
+        return;
+    }
     flatbuffers::FlatBufferBuilder builder;
     const auto msgCid = builder.CreateString(cid);
     auto sourceExpiredBuilder = message::SourceExpiredBuilder(builder);
@@ -229,11 +1028,20 @@ void ReceiveLevels::onSourceExpired(const std::string &cid) const
         message::ReceiveLevelsRespVal::sourceExpired,
         msgSourceExpired.Union());
     builder.Finish(msgReceiveLevelsResp);
-    sendBinaryMessage(builder.GetBufferPointer(), builder.GetSize());
+    queueMessage(builder);
 }
 
-void ReceiveLevels::onSourceLost(const std::string &cid) const
+void ReceiveLevels::onSourceLost(const std::string &cid)
 {
+    if (!alertRules_.empty() && receiver_) {
+        // No frames arrive once the last source is gone, so check source counts now.
+        if (const auto frame = receiver_->lastFrame()) {
+            sendAlerts(*frame);
+        }
+    }
+    if (!wants(message::LevelsField::Sources)) {
+        return;
+    }
     flatbuffers::FlatBufferBuilder builder;
     const auto msgCid = builder.CreateString(cid);
     auto sourceExpiredBuilder = message::SourceExpiredBuilder(builder);
@@ -245,7 +1053,7 @@ void ReceiveLevels::onSourceLost(const std::string &cid) const
         message::ReceiveLevelsRespVal::sourceExpired,
         msgSourceExpired.Union());
     builder.Finish(msgReceiveLevelsResp);
-    sendBinaryMessage(builder.GetBufferPointer(), builder.GetSize());
+    queueMessage(builder);
 }
 
 } // namespace mobilesacn::handler
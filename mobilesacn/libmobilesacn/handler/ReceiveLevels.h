@@ -9,10 +9,24 @@
 #ifndef MOBILESACN_LIBMOBILESACN_HANDLER_RECEIVELEVELS_H
 #define MOBILESACN_LIBMOBILESACN_HANDLER_RECEIVELEVELS_H
 
+#include "AlertRules.h"
 #include "BaseHandler.h"
+#include "ContentionMap.h"
+#include "LocalMerger.h"
 #include "MergeReceiver.h"
 #include "SourceDetector.h"
+#include "SourceTap.h"
+#include "mobilesacn_messages/ReceiveLevelsReq.h"
 #include "sacn/common.h"
+#include <chrono>
+#include <flatbuffers/flatbuffers.h>
+#include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <QTimer>
 
 namespace mobilesacn::handler {
 
@@ -29,33 +43,216 @@ public:
     [[nodiscard]] const char *getProtocol() const override { return kProtocol; }
     [[nodiscard]] QString getDisplayName() const override { return tr("Receive Levels"); }
 
-private:
     struct LastSeen
     {
         std::array<uint8_t, kSacnDmxAddressCount> levels{};
         std::array<uint8_t, kSacnDmxAddressCount> priorities{};
         std::array<std::string, kSacnDmxAddressCount> owners{};
     };
+
+    /**
+     * A run of addresses, where address 1 has start 0.
+     */
+    struct AddressWindow
+    {
+        std::size_t start = 0;
+        std::size_t count = 0;
+    };
+
+    /**
+     * Build a finished LevelsChanged message containing @p lastSeen.
+     *
+     * @param builder
+     * @param lastSeen
+     * @param timestamp
+     * @param arrivalTimestamp When @p lastSeen arrived from the network.
+     * @param fields Parts of @p lastSeen to include.
+     * @param windows Only include these addresses, as slices. Must be within the universe. If
+     * empty, the whole universe is included.
+     */
+    static void buildLevelsChanged(
+        flatbuffers::FlatBufferBuilder &builder,
+        const LastSeen &lastSeen,
+        uint64_t timestamp,
+        flatbuffers::Optional<uint64_t> arrivalTimestamp = flatbuffers::nullopt,
+        message::LevelsField fields = message::LevelsField::ANY,
+        std::span<const AddressWindow> windows = {});
+
+    /**
+     * Build a finished SourceLevels message containing @p source's own levels.
+     *
+     * @param builder
+     * @param cid
+     * @param source
+     * @param timestamp
+     * @param fields Parts of @p source to include. Owners are ignored.
+     * @param windows As in buildLevelsChanged().
+     */
+    static void buildSourceLevels(
+        flatbuffers::FlatBufferBuilder &builder,
+        const std::string &cid,
+        const SourceTap::Source &source,
+        uint64_t timestamp,
+        message::LevelsField fields = message::LevelsField::ANY,
+        std::span<const AddressWindow> windows = {});
+
+    /**
+     * Build a finished WhatIfLevels message containing @p merged.
+     *
+     * @param builder
+     * @param merged
+     * @param owners CID of the source that owns each address. Required to include owners.
+     * @param timestamp
+     * @param fields Parts of @p merged to include.
+     * @param windows As in buildLevelsChanged().
+     */
+    static void buildWhatIfLevels(
+        flatbuffers::FlatBufferBuilder &builder,
+        const LocalMerger::Result &merged,
+        const std::array<std::string, kSacnDmxAddressCount> *owners,
+        uint64_t timestamp,
+        message::LevelsField fields = message::LevelsField::ANY,
+        std::span<const AddressWindow> windows = {});
+
+    /**
+     * Clamp @p windows to the universe, then sort them and merge any that overlap.
+     */
+    static std::vector<AddressWindow> normalizeWindows(std::vector<AddressWindow> windows);
+
+    /**
+     * Build a finished Flicker message listing the differences between @p oldLevels and @p newLevels.
+     *
+     * @param builder
+     * @param oldLevels Levels from the previous frame.
+     * @param newLevels Levels from this frame.
+     * @param referenceLevels Levels captured when flicker finder was started.
+     * @param timestamp
+     * @param arrivalTimestamp When @p newLevels arrived from the network.
+     * @return FALSE if there were no differences, in which case nothing is built.
+     */
+    static bool buildFlicker(
+        flatbuffers::FlatBufferBuilder &builder,
+        const std::array<uint8_t, kSacnDmxAddressCount> &oldLevels,
+        const std::array<uint8_t, kSacnDmxAddressCount> &newLevels,
+        const std::array<uint8_t, kSacnDmxAddressCount> &referenceLevels,
+        uint64_t timestamp,
+        flatbuffers::Optional<uint64_t> arrivalTimestamp = flatbuffers::nullopt);
+
+private:
     static constexpr auto kMessageInterval = std::chrono::milliseconds(100);
+    static constexpr auto kSequenceStatsInterval = std::chrono::seconds(1);
+    static constexpr std::size_t kMaxAddressWindows = 16;
+    static constexpr std::size_t kMaxSelectedSources = 8;
+    static constexpr std::size_t kMaxJournalChanges = 1000;
+    static constexpr std::size_t kMaxAlertRules = 64;
+    /** Fields sent in LevelsChanged. */
+    static constexpr auto kFrameFields = message::LevelsField::Levels
+                                         | message::LevelsField::Priorities
+                                         | message::LevelsField::Owners;
     std::mutex lastSeenMutex_;
     LastSeen lastSeen_;
     MergeReceiver::Ptr receiver_;
+    FrameLatency *universeLatency_ = nullptr;
+    UniverseMetrics *universeMetrics_ = nullptr;
     bool flickerFinder_ = false;
+    /** What the client subscribed to. */
+    message::LevelsField fields_ = message::LevelsField::ANY;
+    /** Addresses the client is viewing, or empty for the whole universe. */
+    std::vector<AddressWindow> windows_;
+    /** Serialized messages waiting to be sent in one frame. */
+    std::vector<QByteArray> batch_;
     std::mutex flickerFinderReferenceBufferMutex_;
     std::array<uint8_t, kSacnDmxAddressCount> flickerFinderReferenceBuffer_{};
+    /** Sources the client wants to see unmerged. */
+    std::unordered_set<etcpal::Uuid> selectedSources_;
+    /** Shared tap on the universe's sources, or nullptr if the client needs none. */
+    SourceTap::Ptr sourceTap_;
+    /** Sources copied from sourceTap_ on each tick. */
+    SourceTap::SourceMap sources_;
+    /** Version of each selected source last sent to the client. */
+    std::unordered_map<etcpal::Uuid, uint64_t> sentSourceVersions_;
+    QTimer *sourceLevelsTimer_;
+    /** Priorities to merge sources with, or nothing if the client is not asking "what if". */
+    std::optional<std::unordered_map<etcpal::Uuid, uint8_t>> whatIfPriorities_;
+    /** Send the what-if merge on the next tick, even if no source changed. */
+    bool whatIfChanged_ = false;
+    /** Tap generation the what-if merge was last sent for. */
+    uint64_t whatIfGeneration_ = 0;
+    QTimer *sequenceStatsTimer_;
+    bool contentionFinder_ = false;
+    /** Last contention map sent, or nothing to send the next one regardless. */
+    std::optional<ContentionMap::Result> lastContention_;
+    /** Tap generation the contention map was last computed for. */
+    uint64_t contentionGeneration_ = 0;
+    AlertRules alertRules_;
+
+    static flatbuffers::Offset<message::LevelsChanged> createLevelsChanged(
+        flatbuffers::FlatBufferBuilder &builder,
+        const std::array<uint8_t, kSacnDmxAddressCount> &levels,
+        const std::array<uint8_t, kSacnDmxAddressCount> &priorities,
+        const std::array<std::string, kSacnDmxAddressCount> *owners,
+        message::LevelsField fields,
+        std::span<const AddressWindow> windows);
 
+    /**
+     * Send @p builder's finished message with any others queued before control returns to the
+     * event loop.
+     */
+    void queueMessage(const flatbuffers::FlatBufferBuilder &builder);
+    void flushBatch();
     void onChangeUniverse(uint16_t universe);
     void onChangeFlickerFinder(bool flickerFinder);
+    void onChangeFields(message::LevelsField fields);
+    void onChangeAddressWindows(const message::AddressWindows &msg);
+    void onChangeSourceSelection(const message::SourceSelection &msg);
+    void onChangeWhatIf(const message::WhatIf &msg);
+    void onChangeContentionFinder(bool contentionFinder);
+    void onJournalQuery(const message::JournalQuery &msg);
+    void onChangeAlertRules(const message::AlertRules &msg);
+    void sendAlerts(const MergedFrame &frame);
+    void onSnapshot(const message::SnapshotReq &msg);
+    void sendSnapshotList();
+    /**
+     * Send the difference between two snapshots, or a snapshot and its universe's current levels.
+     *
+     * A SnapshotDiff is always sent, saying why if there is nothing to compare.
+     *
+     * @return FALSE if a snapshot is missing, so the client's list is out of date.
+     */
+    bool sendSnapshotDiff(const std::string &name, const std::optional<std::string> &other);
+    /**
+     * Start, stop, or move the source tap to match the universe and selected sources.
+     */
+    void updateSourceTap();
+    /**
+     * Send the levels of selected sources that changed since last time, and the what-if merge and
+     * contention map if any source changed.
+     */
+    void sendSourceLevels();
+    void sendWhatIfLevels();
+    void sendContention();
+    void sendSequenceStats();
+    /**
+     * Update the last seen buffers from @p frame and send it to the client.
+     *
+     * @param handlerStart When the handler picked up a live frame, used for latency tracking.
+     *  Empty when replaying a frame that was received earlier.
+     */
+    void sendFrame(
+        const MergedFrame &frame,
+        std::optional<std::chrono::steady_clock::time_point> handlerStart);
+    [[nodiscard]] bool wants(message::LevelsField field) const
+    {
+        return (fields_ & field) != message::LevelsField::NONE;
+    }
 
 private Q_SLOTS:
     void onBinaryMessage(const QByteArray &data);
-    void onSourceUpdated(const SourceDetectorSource &source) const;
-    void onSourceUpdated(const sacn::MergeReceiver::Source &source) const;
-    void onSourceExpired(const std::string &cid) const;
-    void onMergedData(
-        const SacnRecvMergedData &mergedData,
-        const std::array<std::string, kSacnDmxAddressCount> &ownerCids);
-    void onSourceLost(const std::string &cid) const;
+    void onSourceUpdated(const SourceDetectorSource &source);
+    void onSourceUpdated(const sacn::MergeReceiver::Source &source);
+    void onSourceExpired(const std::string &cid);
+    void onMergedData(const MergedFrame::Ptr &frame);
+    void onSourceLost(const std::string &cid);
 };
 
 } // namespace mobilesacn::handler
@@ -0,0 +1,194 @@
+/**
+ * @file SequenceMonitor.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "SequenceMonitor.h"
+#include "mobilesacn/libmobilesacn/Trace.h"
+#include <array>
+#include <ranges>
+#include <vector>
+#include <spdlog/spdlog.h>
+#include <QCoreApplication>
+
+namespace mobilesacn::handler {
+
+SequenceMonitor *SequenceMonitor::get()
+{
+    static SequenceMonitor *instance = []() { return new SequenceMonitor; }();
+    return instance;
+}
+
+SequenceMonitor::SequenceMonitor(QObject *parent) :
+    QObject(parent), socket_(new QUdpSocket(this)), expireTimer_(new QTimer(this))
+{
+    connect(socket_, &QUdpSocket::readyRead, this, &SequenceMonitor::onReadyRead);
+    expireTimer_->setInterval(kExpireInterval);
+    connect(expireTimer_, &QTimer::timeout, this, &SequenceMonitor::expire);
+
+    // Keep reading packets off the main thread. The socket and timer are children, so they move
+    // too.
+    thread_.setObjectName(QStringLiteral("SequenceMonitor"));
+    moveToThread(&thread_);
+    thread_.start();
+    connect(
+        QCoreApplication::instance(),
+        &QCoreApplication::aboutToQuit,
+        QCoreApplication::instance(),
+        [this]() {
+            thread_.quit();
+            thread_.wait();
+        });
+}
+
+void SequenceMonitor::watch(uint16_t universe)
+{
+    QMetaObject::invokeMethod(
+        this, [this, universe]() { addWatcher(universe); }, Qt::QueuedConnection);
+}
+
+void SequenceMonitor::unwatch(uint16_t universe)
+{
+    QMetaObject::invokeMethod(
+        this, [this, universe]() { removeWatcher(universe); }, Qt::QueuedConnection);
+}
+
+SequenceMonitor::SequenceStatsMap SequenceMonitor::statsForUniverse(uint16_t universe) const
+{
+    std::scoped_lock watchedLock(watchedMutex_);
+    const auto it = watched_.find(universe);
+    if (it == watched_.cend()) {
+        return {};
+    }
+    return it->second.stats;
+}
+
+SourceTap::Ptr SequenceMonitor::tapForUniverse(uint16_t universe)
+{
+    std::scoped_lock watchedLock(watchedMutex_);
+    auto &weakTap = taps_[universe];
+    auto tap = weakTap.lock();
+    if (!tap) {
+        tap = std::make_shared<SourceTap>(universe);
+        weakTap = tap;
+    }
+    return tap;
+}
+
+void SequenceMonitor::addWatcher(uint16_t universe)
+{
+    std::scoped_lock watchedLock(watchedMutex_);
+    auto &watched = watched_[universe];
+    if (watched.watchers++ > 0) {
+        return;
+    }
+    SPDLOG_DEBUG("Counting packets on univ {}", universe);
+    watched.metrics = &Metrics::get().forUniverse(universe);
+    // Bound here rather than in the constructor so it happens on the monitor's thread.
+    if (socket_->state() != QAbstractSocket::BoundState) {
+        if (SourceTap::bindSocket(*socket_)) {
+            socket_->setSocketOption(
+                QAbstractSocket::ReceiveBufferSizeSocketOption, kReceiveBufferSize);
+        } else {
+            SPDLOG_ERROR("Could not count packets: {}", socket_->errorString().toStdString());
+        }
+    }
+    if (socket_->state() == QAbstractSocket::BoundState
+        && !SourceTap::joinUniverse(*socket_, universe)) {
+        SPDLOG_ERROR(
+            "Could not count packets on univ {}: {}",
+            universe,
+            socket_->errorString().toStdString());
+    }
+    expireTimer_->start();
+}
+
+void SequenceMonitor::removeWatcher(uint16_t universe)
+{
+    std::scoped_lock watchedLock(watchedMutex_);
+    const auto it = watched_.find(universe);
+    if (it == watched_.end() || --it->second.watchers > 0) {
+        return;
+    }
+    SPDLOG_DEBUG("Stopped counting packets on univ {}", universe);
+    SourceTap::leaveUniverse(*socket_, universe);
+    watched_.erase(it);
+    if (watched_.empty()) {
+        socket_->close();
+        expireTimer_->stop();
+    }
+}
+
+void SequenceMonitor::onReadyRead()
+{
+    MSACN_TRACE_SPAN("SequenceMonitor read");
+    std::array<uint8_t, SourceTap::kMaxPacketSize> buffer;
+    while (socket_->hasPendingDatagrams()) {
+        const auto size
+            = socket_->readDatagram(reinterpret_cast<char *>(buffer.data()), buffer.size());
+        if (size <= 0) {
+            continue;
+        }
+        const auto packet
+            = SourceTap::parseDataPacket(std::span<const uint8_t>(buffer.data(), size));
+        if (!packet) {
+            continue;
+        }
+        SequenceStats::Result result;
+        SourceTap::Ptr tap;
+        {
+            std::scoped_lock watchedLock(watchedMutex_);
+            const auto it = watched_.find(packet->universe);
+            if (it == watched_.end()) {
+                // Another universe's traffic on the shared port.
+                continue;
+            }
+            auto &watched = it->second;
+            auto &sourceStats = watched.stats[packet->cid];
+            const auto lostBefore = sourceStats.lost;
+            result = sourceStats.record(packet->sequence);
+            // Lost packets are only counted once they can't turn up late, so this never goes down.
+            watched.metrics->packetsLost.add(sourceStats.lost - lostBefore);
+            if (result == SequenceStats::Result::Duplicate) {
+                watched.metrics->packetsDuplicated.add();
+            } else if (result == SequenceStats::Result::OutOfOrder) {
+                watched.metrics->packetsOutOfOrder.add();
+            }
+            if (const auto weakTap = taps_.find(packet->universe); weakTap != taps_.end()) {
+                tap = weakTap->second.lock();
+            }
+        }
+        if (tap) {
+            tap->handlePacket(*packet, result);
+        }
+    }
+}
+
+void SequenceMonitor::expire()
+{
+    const auto now = std::chrono::steady_clock::now();
+    std::vector<SourceTap::Ptr> taps;
+    {
+        std::scoped_lock watchedLock(watchedMutex_);
+        for (auto &watched : watched_ | std::views::values) {
+            std::erase_if(watched.stats, [now](const auto &item) {
+                return now - item.second.lastSeen > kSourceTimeout;
+            });
+        }
+        std::erase_if(taps_, [](const auto &item) { return item.second.expired(); });
+        for (const auto &weakTap : taps_ | std::views::values) {
+            if (auto tap = weakTap.lock()) {
+                taps.push_back(std::move(tap));
+            }
+        }
+    }
+    // Outside the lock, so clients asking for stats or taps aren't kept waiting.
+    for (const auto &tap : taps) {
+        tap->expire();
+    }
+}
+
+} // namespace mobilesacn::handler
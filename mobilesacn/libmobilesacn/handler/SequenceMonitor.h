@@ -0,0 +1,100 @@
+/**
+ * @file SequenceMonitor.h
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#ifndef MOBILESACN_LIBMOBILESACN_HANDLER_SEQUENCEMONITOR_H
+#define MOBILESACN_LIBMOBILESACN_HANDLER_SEQUENCEMONITOR_H
+
+#include "SourceTap.h"
+#include "mobilesacn/libmobilesacn/Metrics.h"
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <QObject>
+#include <QThread>
+#include <QTimer>
+#include <QUdpSocket>
+
+namespace mobilesacn::handler {
+
+/**
+ * Count lost, duplicated, and out of order packets from every source on the universes being
+ * received, and feed those packets to the universes' SourceTaps.
+ *
+ * The sACN library discards bad packets without saying so, so this reads the packets itself. One
+ * socket joins every watched universe's multicast group, so each packet is only parsed once. It
+ * runs on its own thread, so a busy main thread doesn't overflow the socket and show up as loss.
+ */
+class SequenceMonitor : public QObject
+{
+    Q_OBJECT
+public:
+    using SequenceStatsMap = std::unordered_map<etcpal::Uuid, SequenceStats>;
+
+    static SequenceMonitor *get();
+
+    SequenceMonitor(const SequenceMonitor &) = delete;
+    SequenceMonitor &operator=(const SequenceMonitor &) = delete;
+
+    /**
+     * Start counting packets on @p universe, if not already.
+     *
+     * Thread-safe. Calls are counted, so counting stops once unwatch() is called as many times.
+     */
+    void watch(uint16_t universe);
+    void unwatch(uint16_t universe);
+
+    /**
+     * Get packet counts for every source sending @p universe.
+     *
+     * Thread-safe.
+     */
+    [[nodiscard]] SequenceStatsMap statsForUniverse(uint16_t universe) const;
+
+    /**
+     * Get the tap for @p universe, creating it if no one else is using it.
+     *
+     * Thread-safe. Use SourceTap::getForUniverse() instead.
+     */
+    [[nodiscard]] SourceTap::Ptr tapForUniverse(uint16_t universe);
+
+private:
+    static constexpr auto kExpireInterval = std::chrono::seconds(1);
+    /** E1.31 network data loss timeout. */
+    static constexpr auto kSourceTimeout = std::chrono::milliseconds(2500);
+    /** Room for bursts of packets while the thread is busy. */
+    static constexpr int kReceiveBufferSize = 1024 * 1024;
+
+    struct Watched
+    {
+        std::size_t watchers = 0;
+        SequenceStatsMap stats;
+        UniverseMetrics *metrics = nullptr;
+    };
+
+    QThread thread_;
+    /** Lives on #thread_. */
+    QUdpSocket *socket_;
+    /** Only changed on #thread_. Locked there when changing, elsewhere when reading. */
+    mutable std::mutex watchedMutex_;
+    std::unordered_map<uint16_t, Watched> watched_;
+    /** Changed on any thread, under #watchedMutex_. Expired taps are removed by expire(). */
+    std::unordered_map<uint16_t, std::weak_ptr<SourceTap>> taps_;
+    QTimer *expireTimer_;
+
+    explicit SequenceMonitor(QObject *parent = nullptr);
+
+    void addWatcher(uint16_t universe);
+    void removeWatcher(uint16_t universe);
+    void onReadyRead();
+    void expire();
+};
+
+} // namespace mobilesacn::handler
+
+#endif //MOBILESACN_LIBMOBILESACN_HANDLER_SEQUENCEMONITOR_H
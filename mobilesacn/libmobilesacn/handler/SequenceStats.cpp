@@ -0,0 +1,57 @@
+/**
+ * @file SequenceStats.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "SequenceStats.h"
+#include <bit>
+
+namespace mobilesacn::handler {
+
+SequenceStats::Result SequenceStats::record(uint8_t sequence)
+{
+    ++received;
+    lastSeen = std::chrono::steady_clock::now();
+    if (!started_) {
+        started_ = true;
+        lastSequence_ = sequence;
+        return Result::InOrder;
+    }
+
+    // Sequence numbers wrap, so compare them as in E1.31 section 6.7.2.
+    const int diff = static_cast<int8_t>(sequence - lastSequence_);
+    if (diff > kWindow || diff <= -kWindow) {
+        restart(sequence);
+        return Result::Restarted;
+    }
+    if (diff <= 0) {
+        const auto bit = 1u << -diff;
+        if ((window_ & bit) != 0) {
+            ++duplicated;
+            return Result::Duplicate;
+        }
+        // Skipped when newer packets arrived, but it wasn't lost after all.
+        window_ |= bit;
+        ++outOfOrder;
+        return Result::OutOfOrder;
+    }
+
+    // Packets leaving the window without having arrived are lost.
+    const auto leaving = window_ >> (kWindow - diff);
+    lost += diff - std::popcount(leaving);
+    window_ = ((window_ << diff) | 1u) & kWindowMask;
+    lastSequence_ = sequence;
+    return Result::InOrder;
+}
+
+void SequenceStats::restart(uint8_t sequence)
+{
+    lost += kWindow - std::popcount(window_);
+    window_ = kWindowMask;
+    lastSequence_ = sequence;
+}
+
+} // namespace mobilesacn::handler
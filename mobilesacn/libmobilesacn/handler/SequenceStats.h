@@ -0,0 +1,72 @@
+/**
+ * @file SequenceStats.h
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#ifndef MOBILESACN_LIBMOBILESACN_HANDLER_SEQUENCESTATS_H
+#define MOBILESACN_LIBMOBILESACN_HANDLER_SEQUENCESTATS_H
+
+#include <chrono>
+#include <cstdint>
+
+namespace mobilesacn::handler {
+
+/**
+ * Count lost, duplicated, and out of order packets from one source, using the sequence numbers in
+ * its E1.31 packets.
+ */
+struct SequenceStats
+{
+    enum class Result
+    {
+        /** The next packet, or the first after some were skipped. */
+        InOrder,
+        /** A packet that was already received. */
+        Duplicate,
+        /** A skipped packet that turned up after newer ones, so it should be discarded. */
+        OutOfOrder,
+        /** So far from the last packet that the source must have restarted. */
+        Restarted,
+    };
+
+    /**
+     * Sequence numbers further than this from the newest packet mean the source restarted, as in
+     * E1.31 section 6.7.2. Also the number of packets a skipped packet has to turn up late.
+     */
+    static constexpr int kWindow = 20;
+
+    uint64_t received = 0;
+    /**
+     * Packets skipped over that never turned up.
+     *
+     * Only counted once the packet is too old to arrive late, so this never goes down.
+     */
+    uint64_t lost = 0;
+    uint64_t duplicated = 0;
+    uint64_t outOfOrder = 0;
+    std::chrono::steady_clock::time_point lastSeen;
+
+    /**
+     * Count a packet with @p sequence.
+     */
+    Result record(uint8_t sequence);
+
+private:
+    static constexpr uint32_t kWindowMask = (1u << kWindow) - 1;
+
+    bool started_ = false;
+    /** Newest sequence number received. */
+    uint8_t lastSequence_ = 0;
+    /** Bit n is set if the packet n before lastSequence_ was received. */
+    uint32_t window_ = kWindowMask;
+
+    /** Count packets missing from the window as lost and start it again at @p sequence. */
+    void restart(uint8_t sequence);
+};
+
+} // namespace mobilesacn::handler
+
+#endif //MOBILESACN_LIBMOBILESACN_HANDLER_SEQUENCESTATS_H
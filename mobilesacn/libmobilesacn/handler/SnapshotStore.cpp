@@ -0,0 +1,264 @@
+/**
+ * @file SnapshotStore.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "SnapshotStore.h"
+#include "mobilesacn/libmobilesacn/Settings.h"
+#include "mobilesacn/libmobilesacn/Trace.h"
+#include "mobilesacn_messages/Snapshot.h"
+#include <algorithm>
+#include <ranges>
+#include <spdlog/spdlog.h>
+#include <unordered_map>
+#include <QCoreApplication>
+
+namespace mobilesacn::handler {
+
+UniverseSnapshot UniverseSnapshot::capture(std::string name, const MergedFrame &frame)
+{
+    UniverseSnapshot snapshot{
+        .name = std::move(name),
+        .universe = frame.universe,
+        .timestamp = frame.arrivalTimestamp,
+        .levels = frame.levels,
+        .priorities = frame.priorities,
+    };
+    std::unordered_map<std::string, uint8_t> ownerIds;
+    for (std::size_t address = 0; address < kSacnDmxAddressCount; ++address) {
+        const auto &cid = frame.ownerCids[address];
+        if (cid.empty()) {
+            snapshot.owners[address] = kNoOwner;
+            continue;
+        }
+        auto it = ownerIds.find(cid);
+        if (it == ownerIds.end()) {
+            if (snapshot.ownerCids.size() == kNoOwner) {
+                snapshot.owners[address] = kNoOwner;
+                continue;
+            }
+            it = ownerIds.emplace(cid, static_cast<uint8_t>(snapshot.ownerCids.size())).first;
+            snapshot.ownerCids.push_back(cid);
+        }
+        snapshot.owners[address] = it->second;
+    }
+    return snapshot;
+}
+
+SnapshotStore *SnapshotStore::get()
+{
+    static SnapshotStore *instance = []() { return new SnapshotStore; }();
+    return instance;
+}
+
+/**
+ * Copy a vector from a stored snapshot into @p buffer.
+ * @internal
+ */
+static void copyBuffer(const flatbuffers::Vector<uint8_t> &vec, UniverseSnapshot::Buffer &buffer)
+{
+    std::copy_n(vec.begin(), std::min<std::size_t>(vec.size(), buffer.size()), buffer.begin());
+}
+
+SnapshotStore::SnapshotStore() :
+    writeTimer_(new QTimer)
+{
+    writerThread_.setObjectName(QStringLiteral("SnapshotWriter"));
+    writeTimer_->setSingleShot(true);
+    writeTimer_->setInterval(kWriteDelay);
+    writeTimer_->moveToThread(&writerThread_);
+    QObject::connect(writeTimer_, &QTimer::timeout, writeTimer_, [this]() { writePending(); });
+    QObject::connect(&writerThread_, &QThread::finished, writeTimer_, &QObject::deleteLater);
+    writerThread_.start();
+    QObject::connect(
+        QCoreApplication::instance(),
+        &QCoreApplication::aboutToQuit,
+        QCoreApplication::instance(),
+        [this]() { stop(); });
+
+    const auto stored = Settings::getSnapshots();
+    if (stored.isEmpty()) {
+        return;
+    }
+    flatbuffers::Verifier verifier(
+        reinterpret_cast<const uint8_t *>(stored.data()), static_cast<std::size_t>(stored.size()));
+    if (!message::VerifySnapshotStoreBuffer(verifier)) {
+        SPDLOG_ERROR("Saved snapshots are corrupt and will not be loaded");
+        return;
+    }
+    const auto msg = message::GetSnapshotStore(stored.data());
+    for (const auto msgSnapshot : *msg->snapshots()) {
+        auto snapshot = std::make_shared<UniverseSnapshot>();
+        snapshot->name = msgSnapshot->name()->str();
+        snapshot->universe = msgSnapshot->universe();
+        snapshot->timestamp = msgSnapshot->timestamp();
+        copyBuffer(*msgSnapshot->levels(), snapshot->levels);
+        copyBuffer(*msgSnapshot->priorities(), snapshot->priorities);
+        for (const auto cid : *msgSnapshot->owners()) {
+            snapshot->ownerCids.push_back(cid->str());
+        }
+        snapshot->owners.fill(UniverseSnapshot::kNoOwner);
+        copyBuffer(*msgSnapshot->ownerIndex(), snapshot->owners);
+        // Don't trust stored indexes to be within ownerCids.
+        std::ranges::replace_if(
+            snapshot->owners,
+            [&snapshot](uint8_t owner) { return owner >= snapshot->ownerCids.size(); },
+            UniverseSnapshot::kNoOwner);
+        snapshots_.emplace(snapshot->name, std::move(snapshot));
+    }
+}
+
+bool SnapshotStore::save(UniverseSnapshot snapshot)
+{
+    if (snapshot.name.empty() || snapshot.name.size() > kMaxNameLength) {
+        return false;
+    }
+    std::scoped_lock lock(mutex_);
+    if (snapshots_.size() >= kMaxSnapshots && !snapshots_.contains(snapshot.name)) {
+        return false;
+    }
+    auto name = snapshot.name;
+    snapshots_[std::move(name)] = std::make_shared<const UniverseSnapshot>(std::move(snapshot));
+    persist();
+    return true;
+}
+
+bool SnapshotStore::remove(const std::string &name)
+{
+    std::scoped_lock lock(mutex_);
+    if (snapshots_.erase(name) == 0) {
+        return false;
+    }
+    persist();
+    return true;
+}
+
+UniverseSnapshot::Ptr SnapshotStore::find(const std::string &name) const
+{
+    std::scoped_lock lock(mutex_);
+    const auto it = snapshots_.find(name);
+    return it != snapshots_.cend() ? it->second : nullptr;
+}
+
+std::vector<UniverseSnapshot::Ptr> SnapshotStore::list() const
+{
+    std::scoped_lock lock(mutex_);
+    std::vector<UniverseSnapshot::Ptr> snapshots;
+    snapshots.reserve(snapshots_.size());
+    std::ranges::copy(snapshots_ | std::views::values, std::back_inserter(snapshots));
+    return snapshots;
+}
+
+std::vector<SnapshotStore::Run> SnapshotStore::diff(
+    const UniverseSnapshot::Buffer &lhsLevels,
+    const UniverseSnapshot::Buffer &lhsPriorities,
+    const UniverseSnapshot::Buffer &rhsLevels,
+    const UniverseSnapshot::Buffer &rhsPriorities)
+{
+    MSACN_TRACE_SPAN("SnapshotStore::diff");
+    std::vector<Run> runs;
+    if (lhsLevels == rhsLevels && lhsPriorities == rhsPriorities) {
+        return runs;
+    }
+    // Compare every address in one pass, which the compiler vectorizes, then collect runs.
+    UniverseSnapshot::Buffer differs;
+    for (std::size_t address = 0; address < kSacnDmxAddressCount; ++address) {
+        differs[address] = static_cast<uint8_t>(
+            (lhsLevels[address] ^ rhsLevels[address])
+            | (lhsPriorities[address] ^ rhsPriorities[address]));
+    }
+    for (std::size_t address = 0; address < kSacnDmxAddressCount; ++address) {
+        if (differs[address] == 0) {
+            continue;
+        }
+        if (!runs.empty() && runs.back().start + runs.back().count == address) {
+            ++runs.back().count;
+        } else {
+            runs.push_back({.start = address, .count = 1});
+        }
+    }
+    return runs;
+}
+
+void SnapshotStore::stop()
+{
+    if (!writerThread_.isRunning()) {
+        return;
+    }
+    QMetaObject::invokeMethod(
+        writeTimer_,
+        [this]() {
+            writeTimer_->stop();
+            writePending();
+        },
+        Qt::BlockingQueuedConnection);
+    writerThread_.quit();
+    writerThread_.wait();
+    std::scoped_lock lock(mutex_);
+    writeTimer_ = nullptr;
+}
+
+void SnapshotStore::persist()
+{
+    if (writeTimer_ == nullptr) {
+        // Stopped, so there is no writer to hand this to.
+        write(snapshots_);
+        return;
+    }
+    pending_ = true;
+    // Restart the timer, so a burst of changes is only written once.
+    QMetaObject::invokeMethod(writeTimer_, qOverload<>(&QTimer::start));
+}
+
+void SnapshotStore::writePending()
+{
+    SnapshotMap snapshots;
+    {
+        std::scoped_lock lock(mutex_);
+        if (!pending_) {
+            return;
+        }
+        pending_ = false;
+        // Snapshots are immutable, so copying the pointers is enough to write them unlocked.
+        snapshots = snapshots_;
+    }
+    SPDLOG_DEBUG("Saving {} snapshots", snapshots.size());
+    write(snapshots);
+}
+
+void SnapshotStore::write(const SnapshotMap &snapshots)
+{
+    MSACN_TRACE_SPAN("SnapshotStore::write");
+    flatbuffers::FlatBufferBuilder builder;
+    std::vector<flatbuffers::Offset<message::Snapshot>> msgSnapshots;
+    msgSnapshots.reserve(snapshots.size());
+    for (const auto &snapshot : snapshots | std::views::values) {
+        const auto msgName = builder.CreateString(snapshot->name);
+        const auto msgLevels
+            = builder.CreateVector(snapshot->levels.data(), snapshot->levels.size());
+        const auto msgPriorities
+            = builder.CreateVector(snapshot->priorities.data(), snapshot->priorities.size());
+        const auto msgOwners = builder.CreateVectorOfStrings(snapshot->ownerCids);
+        const auto msgOwnerIndex
+            = builder.CreateVector(snapshot->owners.data(), snapshot->owners.size());
+        msgSnapshots.push_back(message::CreateSnapshot(
+            builder,
+            msgName,
+            snapshot->universe,
+            snapshot->timestamp,
+            msgLevels,
+            msgPriorities,
+            msgOwners,
+            msgOwnerIndex));
+    }
+    const auto msgSnapshotsVec = builder.CreateVector(msgSnapshots);
+    builder.Finish(message::CreateSnapshotStore(builder, msgSnapshotsVec));
+    Settings::setSnapshots(QByteArray(
+        reinterpret_cast<const char *>(builder.GetBufferPointer()),
+        static_cast<qsizetype>(builder.GetSize())));
+}
+
+} // namespace mobilesacn::handler
@@ -0,0 +1,138 @@
+/**
+ * @file SnapshotStore.h
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#ifndef MOBILESACN_LIBMOBILESACN_HANDLER_SNAPSHOTSTORE_H
+#define MOBILESACN_LIBMOBILESACN_HANDLER_SNAPSHOTSTORE_H
+
+#include "MergeReceiver.h"
+#include "sacn/common.h"
+#include <array>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <QThread>
+#include <QTimer>
+
+namespace mobilesacn::handler {
+
+/**
+ * A universe's merged levels at one point in time.
+ */
+struct UniverseSnapshot
+{
+    using Ptr = std::shared_ptr<const UniverseSnapshot>;
+    using Buffer = std::array<uint8_t, kSacnDmxAddressCount>;
+
+    static constexpr uint8_t kNoOwner = 0xFF;
+
+    std::string name;
+    uint16_t universe = 0;
+    /** Server time the levels arrived from the network. */
+    uint64_t timestamp = 0;
+    Buffer levels{};
+    Buffer priorities{};
+    /** Each owner's CID, once. */
+    std::vector<std::string> ownerCids;
+    /** Index into ownerCids for each address, or kNoOwner. */
+    Buffer owners{};
+
+    /**
+     * Copy @p frame.
+     *
+     * Owners after the first kNoOwner are left out.
+     */
+    static UniverseSnapshot capture(std::string name, const MergedFrame &frame);
+};
+
+/**
+ * Named universe snapshots, kept between executions.
+ *
+ * Changes are written to settings in the background, once they stop arriving. Thread-safe.
+ */
+class SnapshotStore
+{
+public:
+    static constexpr std::size_t kMaxSnapshots = 100;
+    static constexpr std::size_t kMaxNameLength = 64;
+
+    /**
+     * A run of addresses that differ, where address 1 has start 0.
+     */
+    struct Run
+    {
+        std::size_t start = 0;
+        std::size_t count = 0;
+
+        bool operator==(const Run &) const = default;
+    };
+
+    static SnapshotStore *get();
+
+    SnapshotStore(const SnapshotStore &) = delete;
+    SnapshotStore &operator=(const SnapshotStore &) = delete;
+
+    /**
+     * Save @p snapshot, replacing any with the same name.
+     *
+     * @return FALSE if the name is empty or too long, or the store is full.
+     */
+    bool save(UniverseSnapshot snapshot);
+    /**
+     * @return FALSE if there is no snapshot named @p name.
+     */
+    bool remove(const std::string &name);
+    /**
+     * Get the snapshot named @p name, or nullptr if there is none.
+     */
+    [[nodiscard]] UniverseSnapshot::Ptr find(const std::string &name) const;
+    /**
+     * Get every snapshot, sorted by name.
+     */
+    [[nodiscard]] std::vector<UniverseSnapshot::Ptr> list() const;
+
+    /**
+     * Find the addresses where the level or priority differs between @p lhs and @p rhs.
+     *
+     * Owners are not compared, so a backup taking over with the same levels is not a difference.
+     */
+    static std::vector<Run> diff(
+        const UniverseSnapshot::Buffer &lhsLevels,
+        const UniverseSnapshot::Buffer &lhsPriorities,
+        const UniverseSnapshot::Buffer &rhsLevels,
+        const UniverseSnapshot::Buffer &rhsPriorities);
+
+    /**
+     * Save any pending changes and stop the background writer.
+     */
+    void stop();
+
+private:
+    using SnapshotMap = std::map<std::string, UniverseSnapshot::Ptr>;
+    static constexpr auto kWriteDelay = std::chrono::milliseconds(500);
+
+    mutable std::mutex mutex_;
+    SnapshotMap snapshots_;
+    /** Changes not yet saved to settings. */
+    bool pending_ = false;
+    QThread writerThread_;
+    /** Lives on #writerThread_, and nullptr once stopped. Guarded by mutex_. */
+    QTimer *writeTimer_;
+
+    SnapshotStore();
+    /** Schedule the snapshots to be saved. Must hold mutex_. */
+    void persist();
+    void writePending();
+    static void write(const SnapshotMap &snapshots);
+};
+
+} // namespace mobilesacn::handler
+
+#endif //MOBILESACN_LIBMOBILESACN_HANDLER_SNAPSHOTSTORE_H
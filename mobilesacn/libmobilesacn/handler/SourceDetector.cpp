@@ -7,12 +7,80 @@
  */
 
 #include "SourceDetector.h"
+#include "mobilesacn/libmobilesacn/Metrics.h"
 #include "mobilesacn/libmobilesacn/SacnSettings.h"
+#include <algorithm>
 #include <fmt/ranges.h>
 #include <spdlog/spdlog.h>
 
 namespace mobilesacn::handler {
 
+void SourceDetector::Snapshot::updateSource(const etcpal::Uuid &cid, SourceDetectorSource source)
+{
+    auto &current = sources[cid];
+    // Only touch the index for universes that were added or dropped.
+    std::vector<uint16_t> oldUniverses(current.universes);
+    std::vector<uint16_t> newUniverses(source.universes);
+    std::ranges::sort(oldUniverses);
+    std::ranges::sort(newUniverses);
+    std::vector<uint16_t> dropped;
+    std::ranges::set_difference(oldUniverses, newUniverses, std::back_inserter(dropped));
+    std::vector<uint16_t> added;
+    std::ranges::set_difference(newUniverses, oldUniverses, std::back_inserter(added));
+    unindexSource(cid, dropped);
+    indexSource(cid, added);
+    current = std::move(source);
+}
+
+void SourceDetector::Snapshot::removeSource(const etcpal::Uuid &cid)
+{
+    const auto source = sources.find(cid);
+    if (source == sources.end()) {
+        return;
+    }
+    unindexSource(cid, source->second.universes);
+    sources.erase(source);
+}
+
+void SourceDetector::Snapshot::indexSource(
+    const etcpal::Uuid &cid, const std::vector<uint16_t> &universes)
+{
+    for (const auto universe : universes) {
+        auto &cids = universeSources[universe];
+        if (!cids) {
+            activeUniverses.insert(std::ranges::lower_bound(activeUniverses, universe), universe);
+        }
+        // Older snapshots may share the set, so change a copy.
+        auto updated = cids ? std::make_shared<std::unordered_set<etcpal::Uuid>>(*cids)
+                            : std::make_shared<std::unordered_set<etcpal::Uuid>>();
+        updated->insert(cid);
+        cids = std::move(updated);
+    }
+}
+
+void SourceDetector::Snapshot::unindexSource(
+    const etcpal::Uuid &cid, const std::vector<uint16_t> &universes)
+{
+    for (const auto universe : universes) {
+        const auto cids = universeSources.find(universe);
+        if (cids == universeSources.end() || !cids->second->contains(cid)) {
+            continue;
+        }
+        if (cids->second->size() > 1) {
+            // Older snapshots may share the set, so change a copy.
+            auto updated = std::make_shared<std::unordered_set<etcpal::Uuid>>(*cids->second);
+            updated->erase(cid);
+            cids->second = std::move(updated);
+        } else {
+            universeSources.erase(cids);
+            const auto active = std::ranges::lower_bound(activeUniverses, universe);
+            if (active != activeUniverses.end() && *active == universe) {
+                activeUniverses.erase(active);
+            }
+        }
+    }
+}
+
 SourceDetector::~SourceDetector()
 {
     shutdown();
@@ -43,17 +111,30 @@ void SourceDetector::startup()
 
 void SourceDetector::shutdown()
 {
-    std::scoped_lock sourcesLock(sourcesMutex_);
+    std::scoped_lock updateLock(updateMutex_);
     SPDLOG_DEBUG("Stopping SourceDetector");
     sacn::SourceDetector::Shutdown();
-    sources_.clear();
+    publish(std::make_shared<Snapshot>());
+}
+
+SourceDetector::SnapshotPtr SourceDetector::snapshot() const
+{
+    std::scoped_lock snapshotLock(snapshotMutex_);
+    return snapshot_;
+}
+
+SourceDetector::SourceSnapshot SourceDetector::sources() const
+{
+    auto current = snapshot();
+    return {current, &current->sources};
 }
 
-std::unordered_map<etcpal::Uuid, SourceDetectorSource> SourceDetector::sources() const
+void SourceDetector::publish(std::shared_ptr<Snapshot> snapshot)
 {
-    std::scoped_lock sourcesLock(sourcesMutex_);
-    // Return a copy to avoid threading issues.
-    return {sources_};
+    Metrics::get().sacnSources.set(static_cast<int64_t>(snapshot->sources.size()));
+    Metrics::get().sacnUniverses.set(static_cast<int64_t>(snapshot->activeUniverses.size()));
+    std::scoped_lock snapshotLock(snapshotMutex_);
+    snapshot_ = std::move(snapshot);
 }
 
 void SourceDetector::HandleSourceUpdated(
@@ -62,12 +143,17 @@ void SourceDetector::HandleSourceUpdated(
     const std::string &name,
     const std::vector<uint16_t> &sourcedUniverses)
 {
-    std::scoped_lock sourcesLock(sourcesMutex_);
+    std::scoped_lock updateLock(updateMutex_);
 
-    auto &source = sources_[cid];
-    source.cid = cid.ToString();
-    source.name = name;
-    source.universes = sourcedUniverses;
+    const SourceDetectorSource source{
+        .cid = cid.ToString(),
+        .name = name,
+        .universes = sourcedUniverses,
+    };
+    // Readers may still hold the old snapshot, so change a copy.
+    auto updated = std::make_shared<Snapshot>(*snapshot_);
+    updated->updateSource(cid, source);
+    publish(std::move(updated));
     SPDLOG_DEBUG(
         "Source {} ({}) updated with univs {}",
         source.cid,
@@ -79,9 +165,11 @@ void SourceDetector::HandleSourceUpdated(
 void SourceDetector::HandleSourceExpired(
     sacn::RemoteSourceHandle handle, const etcpal::Uuid &cid, const std::string &name)
 {
-    std::scoped_lock sourcesLock(sourcesMutex_);
+    std::scoped_lock updateLock(updateMutex_);
 
-    sources_.erase(cid);
+    auto updated = std::make_shared<Snapshot>(*snapshot_);
+    updated->removeSource(cid);
+    publish(std::move(updated));
     SPDLOG_DEBUG("Source {} ({}) expired", cid.ToString(), name);
     Q_EMIT(sourceExpired(cid.ToString()));
 }
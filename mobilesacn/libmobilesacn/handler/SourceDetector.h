@@ -9,7 +9,11 @@
 #ifndef MOBILESACN_LIBMOBILESACN_HANDLER_SOURCEDETECTOR_H
 #define MOBILESACN_LIBMOBILESACN_HANDLER_SOURCEDETECTOR_H
 
+#include <memory>
 #include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include <sacn/cpp/common.h>
 #include <sacn/cpp/source_detector.h>
 #include <QObject>
@@ -30,6 +34,36 @@ class SourceDetector : public QObject, public sacn::SourceDetector::NotifyHandle
 {
     Q_OBJECT
 public:
+    using SourceMap = std::unordered_map<etcpal::Uuid, SourceDetectorSource>;
+    /** Immutable, so it can be read from any thread without locking. */
+    using SourceSnapshot = std::shared_ptr<const SourceMap>;
+
+    /**
+     * Everything known about the network at one point in time.
+     */
+    struct Snapshot
+    {
+        /** Immutable, so copies of the snapshot share sets for universes that did not change. */
+        using CidSet = std::shared_ptr<const std::unordered_set<etcpal::Uuid>>;
+
+        SourceMap sources;
+        /** CIDs of the sources sending each universe. */
+        std::unordered_map<uint16_t, CidSet> universeSources;
+        /** Universes with at least one source, sorted. */
+        std::vector<uint16_t> activeUniverses;
+
+        /**
+         * Add or replace @p source, keeping the universe index up to date.
+         */
+        void updateSource(const etcpal::Uuid &cid, SourceDetectorSource source);
+        void removeSource(const etcpal::Uuid &cid);
+
+    private:
+        void indexSource(const etcpal::Uuid &cid, const std::vector<uint16_t> &universes);
+        void unindexSource(const etcpal::Uuid &cid, const std::vector<uint16_t> &universes);
+    };
+    using SnapshotPtr = std::shared_ptr<const Snapshot>;
+
     static SourceDetector *get();
 
     SourceDetector(const SourceDetector &) = delete;
@@ -47,7 +81,9 @@ public:
     void HandleSourceExpired(
         sacn::RemoteSourceHandle handle, const etcpal::Uuid &cid, const std::string &name) override;
 
-    [[nodiscard]] std::unordered_map<etcpal::Uuid, SourceDetectorSource> sources() const;
+    [[nodiscard]] SnapshotPtr snapshot() const;
+    /** Shares ownership with the full snapshot. */
+    [[nodiscard]] SourceSnapshot sources() const;
 
 Q_SIGNALS:
     void sourceUpdated(const SourceDetectorSource &source);
@@ -56,8 +92,13 @@ Q_SIGNALS:
 private:
     using QObject::QObject;
 
-    mutable std::mutex sourcesMutex_;
-    std::unordered_map<etcpal::Uuid, SourceDetectorSource> sources_;
+    /** Held while building a new snapshot, so concurrent changes are not lost. */
+    std::mutex updateMutex_;
+    /** Only guards swapping snapshot_. */
+    mutable std::mutex snapshotMutex_;
+    SnapshotPtr snapshot_ = std::make_shared<const Snapshot>();
+
+    void publish(std::shared_ptr<Snapshot> snapshot);
 };
 
 } // namespace mobilesacn::handler
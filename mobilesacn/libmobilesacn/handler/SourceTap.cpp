@@ -0,0 +1,210 @@
+/**
+ * @file SourceTap.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "SourceTap.h"
+#include "SequenceMonitor.h"
+#include "mobilesacn/libmobilesacn/SacnSettings.h"
+#include "mobilesacn/libmobilesacn/util.h"
+#include <algorithm>
+#include <cstring>
+#include <QNetworkInterface>
+
+namespace mobilesacn::handler {
+
+/**
+ * Read a big-endian 16-bit value.
+ * @internal
+ */
+static uint16_t readU16(const uint8_t *data)
+{
+    return static_cast<uint16_t>((data[0] << 8) | data[1]);
+}
+
+/**
+ * Read a big-endian 32-bit value.
+ * @internal
+ */
+static uint32_t readU32(const uint8_t *data)
+{
+    return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16)
+           | (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+}
+
+/**
+ * Get the sACN multicast address for @p universe, in the configured network interface's family.
+ * @internal
+ */
+static QHostAddress multicastGroup(uint16_t universe)
+{
+    if (SacnSettings::get()->sacnNetInt.addr().IsV4()) {
+        // 239.255.<universe>
+        return QHostAddress(0xEFFF0000u | universe);
+    }
+    // ff18::83:00:<universe>
+    Q_IPV6ADDR groupAddr{};
+    groupAddr[0] = 0xFF;
+    groupAddr[1] = 0x18;
+    groupAddr[12] = 0x83;
+    groupAddr[14] = static_cast<quint8>(universe >> 8);
+    groupAddr[15] = static_cast<quint8>(universe & 0xFF);
+    return QHostAddress(groupAddr);
+}
+
+/**
+ * Get the configured network interface.
+ * @internal
+ */
+static QNetworkInterface sacnInterface()
+{
+    const auto &netint = SacnSettings::get()->sacnNetInt;
+    return QNetworkInterface::interfaceFromIndex(static_cast<int>(netint.index()));
+}
+
+SourceTap::Ptr SourceTap::getForUniverse(uint16_t universe)
+{
+    return SequenceMonitor::get()->tapForUniverse(universe);
+}
+
+SourceTap::SourceTap(uint16_t universe) : universe_(universe)
+{
+    // Packets come from the monitor's socket, so make sure it is listening to this universe.
+    SequenceMonitor::get()->watch(universe);
+}
+
+SourceTap::~SourceTap()
+{
+    SequenceMonitor::get()->unwatch(universe_);
+}
+
+bool SourceTap::bindSocket(QUdpSocket &socket)
+{
+    // Share the port with the sACN library's sockets.
+    constexpr auto kBindMode = QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint;
+    const auto address = SacnSettings::get()->sacnNetInt.addr().IsV4() ? QHostAddress::AnyIPv4
+                                                                        : QHostAddress::AnyIPv6;
+    return socket.bind(address, kSacnPort, kBindMode);
+}
+
+bool SourceTap::joinUniverse(QUdpSocket &socket, uint16_t universe)
+{
+    return socket.joinMulticastGroup(multicastGroup(universe), sacnInterface());
+}
+
+bool SourceTap::leaveUniverse(QUdpSocket &socket, uint16_t universe)
+{
+    return socket.leaveMulticastGroup(multicastGroup(universe), sacnInterface());
+}
+
+std::optional<SourceTap::DataPacket> SourceTap::parseDataPacket(std::span<const uint8_t> datagram)
+{
+    // Offsets are from ANSI E1.31.
+    static constexpr std::array<uint8_t, 12> kAcnPacketIdentifier{
+        0x41, 0x53, 0x43, 0x2D, 0x45, 0x31, 0x2E, 0x31, 0x37, 0x00, 0x00, 0x00};
+    static constexpr uint32_t kVectorRootE131Data = 0x00000004;
+    static constexpr uint32_t kVectorE131DataPacket = 0x00000002;
+    static constexpr uint8_t kVectorDmpSetProperty = 0x02;
+    static constexpr std::size_t kStartCodeOffset = 125;
+
+    if (datagram.size() <= kStartCodeOffset) {
+        return {};
+    }
+    const auto data = datagram.data();
+    if (readU16(data) != 0x0010
+        || std::memcmp(data + 4, kAcnPacketIdentifier.data(), kAcnPacketIdentifier.size()) != 0
+        || readU32(data + 18) != kVectorRootE131Data || readU32(data + 40) != kVectorE131DataPacket
+        || data[117] != kVectorDmpSetProperty) {
+        return {};
+    }
+    // Includes the start code.
+    constexpr std::size_t kAddressCount = kSacnDmxAddressCount;
+    const std::size_t valueCount = readU16(data + 123);
+    if (valueCount == 0 || valueCount > kAddressCount + 1
+        || kStartCodeOffset + valueCount > datagram.size()) {
+        return {};
+    }
+
+    EtcPalUuid cid;
+    std::memcpy(cid.data, data + 22, sizeof(cid.data));
+    const auto options = data[112];
+    return DataPacket{
+        .cid = etcpal::Uuid(cid),
+        .priority = data[108],
+        .sequence = data[111],
+        .universe = readU16(data + 113),
+        .preview = (options & 0x80) != 0,
+        .terminated = (options & 0x40) != 0,
+        .startCode = data[kStartCodeOffset],
+        .slots = datagram.subspan(kStartCodeOffset + 1, valueCount - 1),
+    };
+}
+
+uint64_t SourceTap::copySources(SourceMap &sources) const
+{
+    std::scoped_lock lock(mutex_);
+    sources = sources_;
+    return generation_;
+}
+
+void SourceTap::expire()
+{
+    const auto now = std::chrono::steady_clock::now();
+    std::scoped_lock lock(mutex_);
+    const auto expired = std::erase_if(sources_, [now](const auto &item) {
+        return now - item.second.lastSeen > kSourceTimeout;
+    });
+    if (expired > 0) {
+        ++generation_;
+    }
+}
+
+void SourceTap::handlePacket(const DataPacket &packet, SequenceStats::Result sequenceResult)
+{
+    if (packet.preview || sequenceResult == SequenceStats::Result::Duplicate
+        || sequenceResult == SequenceStats::Result::OutOfOrder) {
+        // Discarded, as in E1.31 section 6.7.2.
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    std::scoped_lock lock(mutex_);
+    if (packet.terminated) {
+        if (sources_.erase(packet.cid) > 0) {
+            ++generation_;
+        }
+        return;
+    }
+    auto [it, added] = sources_.try_emplace(packet.cid);
+    auto &source = it->second;
+    source.lastSeen = now;
+
+    constexpr std::size_t kAddressCount = kSacnDmxAddressCount;
+    const auto count = std::min(packet.slots.size(), kAddressCount);
+    std::array<uint8_t, kSacnDmxAddressCount> values{};
+    std::ranges::copy(packet.slots.first(count), values.begin());
+    bool changed = added;
+    if (packet.startCode == kStartCodeLevels) {
+        changed = changed || values != source.levels;
+        source.levels = values;
+        if (now - source.lastPap > kSourceTimeout) {
+            // Not sending per-address priorities, so every address it sends has its priority.
+            std::ranges::fill(values.begin(), values.begin() + count, packet.priority);
+            changed = changed || values != source.priorities;
+            source.priorities = values;
+        }
+    } else if (packet.startCode == kStartCodePap) {
+        source.lastPap = now;
+        changed = changed || values != source.priorities;
+        source.priorities = values;
+    }
+
+    if (changed) {
+        source.version = ++generation_;
+        source.arrivalTimestamp = getNowInMilliseconds();
+    }
+}
+
+} // namespace mobilesacn::handler
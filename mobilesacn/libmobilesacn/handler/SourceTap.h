@@ -0,0 +1,144 @@
+/**
+ * @file SourceTap.h
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#ifndef MOBILESACN_LIBMOBILESACN_HANDLER_SOURCETAP_H
+#define MOBILESACN_LIBMOBILESACN_HANDLER_SOURCETAP_H
+
+#include "SequenceStats.h"
+#include "sacn/common.h"
+#include <array>
+#include <chrono>
+#include <etcpal/cpp/uuid.h>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <QUdpSocket>
+
+namespace mobilesacn::handler {
+
+/**
+ * Keep each source's own levels and priorities for a universe, before merging.
+ *
+ * The sACN library allows only one receiver per universe, and MergeReceiver only reports the
+ * merged result. So SequenceMonitor reads the E1.31 data packets from its socket and feeds them to
+ * the universe's tap.
+ *
+ * One tap per universe is shared by every client looking at it. Thread-safe.
+ */
+class SourceTap
+{
+public:
+    using Ptr = std::shared_ptr<SourceTap>;
+
+    /**
+     * An E1.31 data packet. Points into the datagram it was parsed from.
+     */
+    struct DataPacket
+    {
+        etcpal::Uuid cid;
+        uint8_t priority = 0;
+        uint8_t sequence = 0;
+        uint16_t universe = 0;
+        bool preview = false;
+        bool terminated = false;
+        uint8_t startCode = 0;
+        /** Slots after the start code. */
+        std::span<const uint8_t> slots;
+    };
+
+    struct Source
+    {
+        std::array<uint8_t, kSacnDmxAddressCount> levels{};
+        /** Per-address priorities, or the universe priority if the source is not sending them. */
+        std::array<uint8_t, kSacnDmxAddressCount> priorities{};
+        std::chrono::steady_clock::time_point lastSeen;
+        std::chrono::steady_clock::time_point lastPap;
+        /** Milliseconds since the Unix epoch the last change arrived, for sending to clients. */
+        uint64_t arrivalTimestamp = 0;
+        /** The tap's generation when levels or priorities last changed. */
+        uint64_t version = 0;
+    };
+
+    /** Largest possible E1.31 data packet. */
+    static constexpr std::size_t kMaxPacketSize = 638;
+
+    using SourceMap = std::unordered_map<etcpal::Uuid, Source>;
+
+    /**
+     * Get the tap for @p universe, shared with every other client looking at it.
+     */
+    static Ptr getForUniverse(uint16_t universe);
+
+    /**
+     * Use getForUniverse() instead, so taps are shared.
+     */
+    explicit SourceTap(uint16_t universe);
+    ~SourceTap();
+
+    SourceTap(const SourceTap &) = delete;
+    SourceTap &operator=(const SourceTap &) = delete;
+
+    /**
+     * Parse an E1.31 data packet.
+     *
+     * @return The packet, or nothing if @p datagram is not a valid data packet.
+     */
+    static std::optional<DataPacket> parseDataPacket(std::span<const uint8_t> datagram);
+
+    /**
+     * Bind @p socket to the sACN port on the configured network interface's address family.
+     *
+     * The port is shared with the sACN library's sockets.
+     */
+    static bool bindSocket(QUdpSocket &socket);
+
+    /**
+     * Receive @p universe's multicast traffic on @p socket, which must already be bound.
+     */
+    static bool joinUniverse(QUdpSocket &socket, uint16_t universe);
+    static bool leaveUniverse(QUdpSocket &socket, uint16_t universe);
+
+    [[nodiscard]] uint16_t universe() const { return universe_; }
+
+    /**
+     * Copy every source into @p sources.
+     *
+     * @return The generation, which changes whenever a source changes, starts, or stops.
+     */
+    uint64_t copySources(SourceMap &sources) const;
+
+    /**
+     * Update a source from @p packet, which must be for this universe.
+     *
+     * @param sequenceResult How the packet's sequence number compares with the source's last.
+     */
+    void handlePacket(const DataPacket &packet, SequenceStats::Result sequenceResult);
+
+    /**
+     * Forget sources that have stopped sending.
+     */
+    void expire();
+
+private:
+    static constexpr quint16 kSacnPort = 5568;
+    /** E1.31 network data loss timeout. */
+    static constexpr auto kSourceTimeout = std::chrono::milliseconds(2500);
+    static constexpr uint8_t kStartCodeLevels = 0x00;
+    static constexpr uint8_t kStartCodePap = 0xDD;
+
+    const uint16_t universe_;
+    mutable std::mutex mutex_;
+    SourceMap sources_;
+    uint64_t generation_ = 0;
+};
+
+} // namespace mobilesacn::handler
+
+#endif //MOBILESACN_LIBMOBILESACN_HANDLER_SOURCETAP_H
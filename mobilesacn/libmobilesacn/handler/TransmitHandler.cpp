@@ -9,8 +9,9 @@
 #include "TransmitHandler.h"
 #include "mobilesacn/libmobilesacn/SacnCidGenerator.h"
 #include "mobilesacn/libmobilesacn/SacnSettings.h"
+#include "mobilesacn/libmobilesacn/Trace.h"
+#include "mobilesacn_config.h"
 #include <spdlog/spdlog.h>
-#include <QApplication>
 
 namespace mobilesacn::handler {
 
@@ -33,7 +34,7 @@ std::string TransmitHandler::getSourceName() const
 {
     const auto clientIpAddr = ws()->peerAddress().toString();
     return tr("%1 (%2 %3)")
-        .arg(qApp->applicationDisplayName(), clientIpAddr, getDisplayName())
+        .arg(QString::fromUtf8(config::kProjectDisplayName), clientIpAddr, getDisplayName())
         .toStdString();
 }
 
@@ -111,6 +112,7 @@ void TransmitHandler::stopTransmitting()
 
 void TransmitHandler::sendLevelsAndPap()
 {
+    MSACN_TRACE_SPAN("Transmit update");
     if (currentlyTransmitting()) {
         sacn_.UpdateLevelsAndPap(
             univSettings_.universe,
@@ -32,15 +32,21 @@ void TransmitLevels::onBinaryMessage(const QByteArray &data)
 void TransmitLevels::onChangeLevels(const uint8_t *levelsData)
 {
     std::memcpy(levelBuf_.data(), levelsData, levelBuf_.size());
+    updatePap(levelBuf_, papBuf_, univSettings_.priority);
+    sendLevelsAndPap();
+}
 
+void TransmitLevels::updatePap(
+    const std::array<uint8_t, kSacnDmxAddressCount> &levels,
+    std::array<uint8_t, kSacnDmxAddressCount> &pap,
+    const uint8_t priority)
+{
     // Addresses set to 0 also get a PAP priority of 0 (i.e. unused).
-    auto levelsIt = levelBuf_.cbegin();
-    auto papIt = papBuf_.begin();
-    for (; levelsIt != levelBuf_.cend() && papIt != papBuf_.end(); ++levelsIt, ++papIt) {
-        *papIt = *levelsIt == 0 ? 0 : univSettings_.priority;
+    auto levelsIt = levels.cbegin();
+    auto papIt = pap.begin();
+    for (; levelsIt != levels.cend() && papIt != pap.end(); ++levelsIt, ++papIt) {
+        *papIt = *levelsIt == 0 ? 0 : priority;
     }
-    
-    sendLevelsAndPap();
 }
 
 } // namespace mobilesacn::handler
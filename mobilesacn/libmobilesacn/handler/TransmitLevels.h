@@ -26,6 +26,16 @@ class TransmitLevels final : public TransmitHandler {
     [[nodiscard]] const char *getProtocol() const override { return kProtocol; }
     [[nodiscard]] QString getDisplayName() const override { return tr("Transmit"); }
 
+    /**
+     * Fill @p pap with @p priority for every address in @p levels that is not 0.
+     *
+     * Addresses set to 0 get a PAP priority of 0 (i.e. unused).
+     */
+    static void updatePap(
+        const std::array<uint8_t, kSacnDmxAddressCount> &levels,
+        std::array<uint8_t, kSacnDmxAddressCount> &pap,
+        uint8_t priority);
+
 protected Q_SLOTS:
     void onBinaryMessage(const QByteArray &data) override;
 
@@ -0,0 +1,41 @@
+/**
+ * @file logging.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "logging.h"
+#include <spdlog/async.h>
+#include <spdlog/spdlog.h>
+
+namespace mobilesacn {
+
+/** Messages waiting to be written. Sized to ride out a slow disk during a burst of debug logs. */
+static constexpr std::size_t kQueueSize = 8192;
+
+void setupAsyncLogging(std::vector<spdlog::sink_ptr> sinks, spdlog::level::level_enum level)
+{
+    spdlog::init_thread_pool(kQueueSize, 1);
+    auto logger = std::make_shared<spdlog::async_logger>(
+        spdlog::default_logger()->name(),
+        sinks.begin(),
+        sinks.end(),
+        spdlog::thread_pool(),
+        spdlog::async_overflow_policy::overrun_oldest);
+    logger->set_level(level);
+    logger->flush_on(spdlog::level::warn);
+    spdlog::set_default_logger(std::move(logger));
+}
+
+uint64_t droppedLogMessages()
+{
+    const auto threadPool = spdlog::thread_pool();
+    if (!threadPool) {
+        return 0;
+    }
+    return threadPool->overrun_counter();
+}
+
+} // namespace mobilesacn
@@ -0,0 +1,35 @@
+/**
+ * @file logging.h
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#ifndef MOBILESACN_LIBMOBILESACN_LOGGING_H
+#define MOBILESACN_LIBMOBILESACN_LOGGING_H
+
+#include <cstdint>
+#include <spdlog/common.h>
+#include <vector>
+
+namespace mobilesacn {
+
+/**
+ * Replace the default logger with one that writes to @p sinks on a background thread.
+ *
+ * Messages are formatted on the calling thread only if @p level allows them, then queued. When
+ * the queue is full the oldest messages are dropped, so logging never blocks the caller.
+ *
+ * Call spdlog::shutdown() before exiting to flush the queue.
+ */
+void setupAsyncLogging(std::vector<spdlog::sink_ptr> sinks, spdlog::level::level_enum level);
+
+/**
+ * Get the number of messages dropped because the queue was full.
+ */
+uint64_t droppedLogMessages();
+
+} // namespace mobilesacn
+
+#endif //MOBILESACN_LIBMOBILESACN_LOGGING_H
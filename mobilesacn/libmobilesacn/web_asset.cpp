@@ -0,0 +1,123 @@
+/**
+ * @file web_asset.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "web_asset.h"
+#include <array>
+#include <brotli/encode.h>
+#include <cstdio>
+#include <unordered_map>
+#include <zlib.h>
+
+namespace mobilesacn::webasset {
+
+std::optional<std::string> gzipCompress(std::string_view data, int level)
+{
+    z_stream stream{};
+    // Adding 16 to the window bits writes a gzip header instead of a zlib header.
+    if (deflateInit2(&stream, level, Z_DEFLATED, 15 + 16, 9, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return {};
+    }
+    std::string compressed(deflateBound(&stream, data.size()), '\0');
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+    stream.avail_in = data.size();
+    stream.next_out = reinterpret_cast<Bytef *>(compressed.data());
+    stream.avail_out = compressed.size();
+    const auto res = deflate(&stream, Z_FINISH);
+    deflateEnd(&stream);
+    if (res != Z_STREAM_END) {
+        return {};
+    }
+    compressed.resize(stream.total_out);
+    return compressed;
+}
+
+std::optional<std::string> brotliCompress(std::string_view data, int quality)
+{
+    std::size_t compressedSize = BrotliEncoderMaxCompressedSize(data.size());
+    if (compressedSize == 0) {
+        return {};
+    }
+    std::string compressed(compressedSize, '\0');
+    if (!BrotliEncoderCompress(
+            quality,
+            BROTLI_DEFAULT_WINDOW,
+            BROTLI_MODE_GENERIC,
+            data.size(),
+            reinterpret_cast<const uint8_t *>(data.data()),
+            &compressedSize,
+            reinterpret_cast<uint8_t *>(compressed.data()))) {
+        return {};
+    }
+    compressed.resize(compressedSize);
+    return compressed;
+}
+
+bool worthCompressing(std::string_view original, const std::optional<std::string> &compressed)
+{
+    // Already-compressed formats (e.g. PNG) don't get any smaller.
+    return compressed && compressed->size() < original.size() * 9 / 10;
+}
+
+std::string contentType(const std::filesystem::path &path)
+{
+    // Everything Vite might output.
+    static const std::unordered_map<std::string, std::string> kContentTypes{
+        {".css", "text/css"},
+        {".html", "text/html"},
+        {".ico", "image/vnd.microsoft.icon"},
+        {".jpeg", "image/jpeg"},
+        {".jpg", "image/jpeg"},
+        {".js", "text/javascript"},
+        {".json", "application/json"},
+        {".map", "application/json"},
+        {".mjs", "text/javascript"},
+        {".png", "image/png"},
+        {".svg", "image/svg+xml"},
+        {".ttf", "font/ttf"},
+        {".txt", "text/plain"},
+        {".wasm", "application/wasm"},
+        {".webmanifest", "application/manifest+json"},
+        {".webp", "image/webp"},
+        {".woff", "font/woff"},
+        {".woff2", "font/woff2"},
+    };
+    const auto contentType = kContentTypes.find(path.extension().string());
+    if (contentType == kContentTypes.cend()) {
+        return "application/octet-stream";
+    }
+    return contentType->second;
+}
+
+std::string contentHash(std::string_view data)
+{
+    // This only needs to change when the content does, so two fast non-cryptographic hashes are
+    // plenty.
+    uint64_t fnv = 0xcbf29ce484222325;
+    for (const auto c : data) {
+        fnv ^= static_cast<uint8_t>(c);
+        fnv *= 0x100000001b3;
+    }
+    const auto crc = crc32(
+        crc32(0, nullptr, 0), reinterpret_cast<const Bytef *>(data.data()), data.size());
+    std::array<char, 25> hash{};
+    std::snprintf(
+        hash.data(),
+        hash.size(),
+        "%016llx%08lx",
+        static_cast<unsigned long long>(fnv),
+        static_cast<unsigned long>(crc));
+    return hash.data();
+}
+
+bool isImmutable(std::string_view path)
+{
+    // Vite puts content-hashed bundles here.
+    return path.starts_with("assets/");
+}
+
+} // namespace mobilesacn::webasset
@@ -0,0 +1,53 @@
+/**
+ * @file web_asset.h
+ *
+ * Helpers shared by the static file cache and the Web UI embedder.
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#ifndef MOBILESACN_LIBMOBILESACN_WEB_ASSET_H
+#define MOBILESACN_LIBMOBILESACN_WEB_ASSET_H
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace mobilesacn::webasset {
+
+/**
+ * Compress @p data with gzip at zlib @p level.
+ */
+std::optional<std::string> gzipCompress(std::string_view data, int level);
+
+/**
+ * Compress @p data with brotli at @p quality.
+ */
+std::optional<std::string> brotliCompress(std::string_view data, int quality);
+
+/**
+ * Is @p compressed worth sending instead of @p original?
+ */
+bool worthCompressing(std::string_view original, const std::optional<std::string> &compressed);
+
+/**
+ * Get the content type for the file at @p path, based on its extension.
+ */
+std::string contentType(const std::filesystem::path &path);
+
+/**
+ * Get a hash of @p data suitable for use in an ETag.
+ */
+std::string contentHash(std::string_view data);
+
+/**
+ * Can the file at @p path (relative to the web root) be cached forever?
+ */
+bool isImmutable(std::string_view path);
+
+} // namespace mobilesacn::webasset
+
+#endif //MOBILESACN_LIBMOBILESACN_WEB_ASSET_H
@@ -0,0 +1,135 @@
+/**
+ * @file webui_embedder.cpp
+ *
+ * Compile the built Web UI into a C++ source file.
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "web_asset.h"
+#include <algorithm>
+#include <brotli/encode.h>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace mobilesacn;
+
+/**
+ * Write @p data as the initializer for a byte array named @p name.
+ *
+ * @return The expression to use for a span of the array.
+ */
+static std::string writeArray(std::ostream &out, const std::string &name, std::string_view data)
+{
+    if (data.empty()) {
+        return "{}";
+    }
+    out << "alignas(16) constexpr uint8_t " << name << "[] = {";
+    for (std::size_t ix = 0; ix < data.size(); ++ix) {
+        if (ix % 16 == 0) {
+            out << "\n    ";
+        }
+        out << static_cast<unsigned int>(static_cast<uint8_t>(data[ix])) << ',';
+    }
+    out << "\n};\n";
+    return name;
+}
+
+/**
+ * Quote @p str as a C++ string literal.
+ */
+static std::string quote(std::string_view str)
+{
+    std::string quoted("\"");
+    for (const auto c : str) {
+        if (c == '"' || c == '\\') {
+            quoted.push_back('\\');
+        }
+        quoted.push_back(c);
+    }
+    quoted.push_back('"');
+    return quoted;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 3) {
+        std::cout << "Usage: " << argv[0] << " <web root> <out file>" << std::endl;
+        return 1;
+    }
+
+    const std::filesystem::path webRoot(argv[1]);
+    const std::filesystem::path outPath(argv[2]);
+
+    // Sort so the output is reproducible.
+    std::vector<std::filesystem::path> files;
+    for (const auto &entry : std::filesystem::recursive_directory_iterator(webRoot)) {
+        if (entry.is_regular_file()) {
+            files.push_back(entry.path());
+        }
+    }
+    if (files.empty()) {
+        std::cerr << "No files found in " << webRoot << std::endl;
+        return 1;
+    }
+    std::ranges::sort(files);
+
+    std::ostringstream arrays;
+    std::ostringstream table;
+    for (std::size_t ix = 0; ix < files.size(); ++ix) {
+        const auto &filePath = files[ix];
+        std::ifstream in(filePath, std::ios_base::in | std::ios::binary);
+        if (!in.is_open()) {
+            std::cerr << "Failed to open file " << filePath << std::endl;
+            return 1;
+        }
+        const std::string data{
+            std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+        const auto path = filePath.lexically_relative(webRoot).generic_string();
+
+        // Compression is done once here, so use the best settings available.
+        const auto gzip = webasset::gzipCompress(data, 9);
+        const auto brotli = webasset::brotliCompress(data, BROTLI_MAX_QUALITY);
+
+        const auto arrayName = "kAsset" + std::to_string(ix);
+        arrays << "// " << path << '\n';
+        const auto identitySpan = writeArray(arrays, arrayName, data);
+        const auto gzipSpan = webasset::worthCompressing(data, gzip)
+                                  ? writeArray(arrays, arrayName + "Gzip", *gzip)
+                                  : "{}";
+        const auto brotliSpan = webasset::worthCompressing(data, brotli)
+                                    ? writeArray(arrays, arrayName + "Brotli", *brotli)
+                                    : "{}";
+
+        table << "    {" << quote(path) << ", " << quote(webasset::contentType(filePath)) << ", "
+              << quote(webasset::contentHash(data)) << ", "
+              << (webasset::isImmutable(path) ? "true" : "false") << ", " << identitySpan << ", "
+              << gzipSpan << ", " << brotliSpan << "},\n";
+    }
+
+    std::ofstream out(outPath, std::ios_base::out | std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Failed to open file " << outPath << std::endl;
+        return 1;
+    }
+    out << "// Generated by webui_embedder. Do not edit.\n\n"
+        << "#include \"mobilesacn/libmobilesacn/embedded_webui.h\"\n\n"
+        << "namespace mobilesacn {\n\n"
+        << "namespace {\n\n"
+        << arrays.str() << '\n'
+        << "constexpr EmbeddedWebAsset kAssets[] = {\n"
+        << table.str() << "};\n\n"
+        << "} // namespace\n\n"
+        << "std::span<const EmbeddedWebAsset> embeddedWebAssets()\n"
+        << "{\n"
+        << "    return kAssets;\n"
+        << "}\n\n"
+        << "} // namespace mobilesacn\n";
+
+    return 0;
+}
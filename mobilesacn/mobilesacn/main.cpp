@@ -7,6 +7,7 @@
  */
 
 #include "../libmobilesacn/Settings.h"
+#include "../libmobilesacn/logging.h"
 #include "MainWindow.h"
 #include "log_files.h"
 #include "mobilesacn_config.h"
@@ -14,9 +15,11 @@
 #include <etcpal/cpp/common.h>
 #include <fmt/chrono.h>
 #include <fmt/format.h>
+#include <memory>
 #include <spdlog/sinks/rotating_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
+#include <vector>
 #include <QApplication>
 #include <QMessageBox>
 #include <QStandardPaths>
@@ -30,19 +33,27 @@ using namespace mobilesacn;
 
 static constexpr auto kEtcPalFeatures = ETCPAL_FEATURE_LOGGING | ETCPAL_FEATURE_NETINTS;
 
-void setup_logging()
+void setup_logging(const spdlog::sink_ptr &sentry_sink)
 {
     // Cap log file size at 1MB before rotating.  Keep at most 5 log files.
     auto file_sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
         get_log_path(), 1024 * 1024, 5, true);
     file_sink->set_level(spdlog::level::debug);
     auto stdout_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
-    spdlog::default_logger()->sinks() = {stdout_sink, file_sink};
-    spdlog::default_logger()->set_level(spdlog::level::debug);
-    spdlog::default_logger()->flush_on(spdlog::level::warn);
+    std::vector<spdlog::sink_ptr> sinks{stdout_sink, file_sink};
+    if (sentry_sink) {
+        // Sinks can't be added once the async logger's thread is running.
+        sinks.push_back(sentry_sink);
+    }
+    setupAsyncLogging(std::move(sinks), spdlog::level::debug);
 }
 
-void setup_sentry()
+/**
+ * Initialize Sentry.
+ *
+ * @return A sink sending logged errors to Sentry, or nullptr when Sentry is not configured.
+ */
+spdlog::sink_ptr setup_sentry()
 {
 #ifdef SENTRY_DSN
     // Set options.
@@ -61,7 +72,6 @@ void setup_sentry()
     // Send logged messages to Sentry.
     auto sentry_sink = std::make_shared<SentryLogSink<std::mutex>>(spdlog::level::err);
     sentry_sink->set_level(spdlog::level::err);
-    spdlog::default_logger()->sinks().push_back(sentry_sink);
 
     sentry_init(options);
 
@@ -77,6 +87,10 @@ void setup_sentry()
     sentry_value_set_by_key(
         context_app, "app_build_timestamp", sentry_value_new_string(build_timestamp_str.c_str()));
     sentry_set_context("app", context_app);
+
+    return sentry_sink;
+#else
+    return nullptr;
 #endif
 }
 
@@ -90,8 +104,7 @@ int main(int argc, char *argv[])
     app.setApplicationVersion(mobilesacn::config::kProjectVersion);
     app.setWindowIcon(QIcon(":/logo.svg"));
 
-    setup_logging();
-    setup_sentry();
+    setup_logging(setup_sentry());
 
     // Init EtcPal.
     etcpal_init(kEtcPalFeatures);
@@ -104,6 +117,9 @@ int main(int argc, char *argv[])
     // Deinit etcpal.
     etcpal_deinit(kEtcPalFeatures);
 
+    // Flush queued log messages while the Sentry sink can still send them.
+    spdlog::shutdown();
+
 #ifdef SENTRY_DSN
     sentry_close();
 #endif
@@ -0,0 +1,211 @@
+/**
+ * @file LoadTest.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "LoadTest.h"
+#include <algorithm>
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+
+namespace mobilesacn::loadtest {
+
+/**
+ * Get the @p pct percentile of @p values, which must be sorted.
+ * @internal
+ */
+template<typename T>
+static T percentile(const std::vector<T> &values, double pct)
+{
+    if (values.empty()) {
+        return {};
+    }
+    const auto ix = static_cast<std::size_t>(pct / 100.0 * static_cast<double>(values.size() - 1));
+    return values[ix];
+}
+
+LoadTest::LoadTest(Options options, QObject *parent) :
+    QObject(parent), options_(std::move(options)), nam_(new QNetworkAccessManager(this))
+{
+    rampTimer_.setInterval(options_.rampInterval);
+    connect(&rampTimer_, &QTimer::timeout, this, &LoadTest::startNextClient);
+}
+
+void LoadTest::start()
+{
+    // Websockets are served on the same port as the Web UI.
+    QUrl wsRoot(options_.serverUrl);
+    wsRoot.setScheme(
+        wsRoot.scheme() == QStringLiteral("https") ? QStringLiteral("wss") : QStringLiteral("ws"));
+    wsRoot.setPath({});
+    createClients(wsRoot);
+}
+
+void LoadTest::createClients(const QUrl &wsRoot)
+{
+    unsigned int id = 0;
+    for (const auto &[kind, count] : options_.clientCounts) {
+        QUrl url(wsRoot);
+        url.setPath(QStringLiteral("/%1").arg(LoadTestClient::kindName(kind)));
+        for (unsigned int ix = 0; ix < count; ++ix) {
+            auto client = new LoadTestClient(
+                ++id,
+                LoadTestClient::Options{
+                    .kind = kind,
+                    .url = url,
+                    .universe = options_.universe,
+                    .sendRate = options_.sendRate,
+                },
+                this);
+            connect(client, &LoadTestClient::finished, this, &LoadTest::onClientFinished);
+            clients_.push_back(client);
+        }
+    }
+    if (clients_.empty()) {
+        SPDLOG_CRITICAL("No clients requested.");
+        Q_EMIT(finished(1));
+        return;
+    }
+
+    SPDLOG_INFO("Starting {} clients against {}", clients_.size(), wsRoot.toString().toStdString());
+    rampTimer_.start();
+}
+
+void LoadTest::startNextClient()
+{
+    if (nextClient_ >= clients_.size()) {
+        rampTimer_.stop();
+        SPDLOG_INFO("All clients started, measuring for {}", options_.duration);
+        QTimer::singleShot(options_.duration, this, &LoadTest::stopClients);
+        return;
+    }
+    clients_[nextClient_++]->start();
+}
+
+void LoadTest::stopClients()
+{
+    SPDLOG_INFO("Stopping clients");
+    for (auto client : clients_) {
+        client->stop();
+    }
+    // Don't wait forever on a server that has stopped responding.
+    QTimer::singleShot(std::chrono::seconds(5), this, &LoadTest::report);
+}
+
+void LoadTest::onClientFinished()
+{
+    ++finishedClients_;
+    if (finishedClients_ == clients_.size()) {
+        report();
+    }
+}
+
+void LoadTest::report()
+{
+    if (reported_) {
+        return;
+    }
+    reported_ = true;
+
+    // Summarize by handler.
+    QJsonArray clientsJson;
+    for (const auto &[kind, count] : options_.clientCounts) {
+        if (count == 0) {
+            continue;
+        }
+        std::vector<qint64> setupTimes;
+        std::vector<double> messageRates;
+        std::vector<int64_t> latencies;
+        std::vector<int64_t> serverLatencies;
+        unsigned int connectedClients = 0;
+        uint64_t staleFrames = 0;
+        uint64_t malformedMessages = 0;
+        unsigned int disconnects = 0;
+        unsigned int errors = 0;
+        for (const auto client : clients_) {
+            if (client->kind() != kind) {
+                continue;
+            }
+            const auto &stats = client->stats();
+            clientsJson.append(client->statsJson());
+            if (stats.setupTime < 0) {
+                continue;
+            }
+            ++connectedClients;
+            setupTimes.push_back(stats.setupTime);
+            if (stats.connectedTime > 0) {
+                messageRates.push_back(
+                    static_cast<double>(stats.messagesReceived) * 1000.0
+                    / static_cast<double>(stats.connectedTime));
+            }
+            latencies.insert(latencies.end(), stats.latencies.cbegin(), stats.latencies.cend());
+            serverLatencies.insert(
+                serverLatencies.end(), stats.serverLatencies.cbegin(), stats.serverLatencies.cend());
+            staleFrames += stats.staleFrames;
+            malformedMessages += stats.malformedMessages;
+            disconnects += stats.disconnects;
+            errors += stats.errors;
+        }
+        std::ranges::sort(setupTimes);
+        std::ranges::sort(messageRates);
+        std::ranges::sort(latencies);
+        std::ranges::sort(serverLatencies);
+
+        fmt::print(
+            "{}: {}/{} clients connected\n",
+            LoadTestClient::kindName(kind),
+            connectedClients,
+            count);
+        fmt::print(
+            "  Setup time (ms):   p50 {} / p95 {} / max {}\n",
+            percentile(setupTimes, 50),
+            percentile(setupTimes, 95),
+            setupTimes.empty() ? 0 : setupTimes.back());
+        if (kind == LoadTestClient::Kind::ReceiveLevels) {
+            fmt::print(
+                "  Messages/s:        min {:.1f} / p50 {:.1f} / max {:.1f}\n",
+                messageRates.empty() ? 0.0 : messageRates.front(),
+                percentile(messageRates, 50),
+                messageRates.empty() ? 0.0 : messageRates.back());
+            fmt::print(
+                "  Latency (ms):      p50 {} / p95 {} / p99 {} / max {}\n",
+                percentile(latencies, 50),
+                percentile(latencies, 95),
+                percentile(latencies, 99),
+                latencies.empty() ? 0 : latencies.back());
+            fmt::print(
+                "  In server (ms):    p50 {} / p95 {} / p99 {} / max {}\n",
+                percentile(serverLatencies, 50),
+                percentile(serverLatencies, 95),
+                percentile(serverLatencies, 99),
+                serverLatencies.empty() ? 0 : serverLatencies.back());
+            fmt::print("  Stale frames:      {} of {}\n", staleFrames, latencies.size());
+            fmt::print("  Malformed:         {}\n", malformedMessages);
+        }
+        fmt::print("  Disconnects:       {}\n", disconnects);
+        fmt::print("  Errors:            {}\n", errors);
+    }
+
+    if (!options_.jsonPath.isEmpty()) {
+        QFile jsonFile(options_.jsonPath);
+        if (jsonFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            jsonFile.write(QJsonDocument(clientsJson).toJson());
+            SPDLOG_INFO("Wrote per-client results to {}", options_.jsonPath.toStdString());
+        } else {
+            SPDLOG_ERROR("Could not write {}", options_.jsonPath.toStdString());
+        }
+    }
+
+    Q_EMIT(finished(0));
+}
+
+} // namespace mobilesacn::loadtest
@@ -0,0 +1,71 @@
+/**
+ * @file LoadTest.h
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#ifndef MOBILESACN_MOBILESACN_LOADTEST_LOADTEST_H
+#define MOBILESACN_MOBILESACN_LOADTEST_LOADTEST_H
+
+#include "LoadTestClient.h"
+#include <chrono>
+#include <map>
+#include <QNetworkAccessManager>
+#include <QTimer>
+
+namespace mobilesacn::loadtest {
+
+/**
+ * Open many websocket connections to a running server and report how well it keeps up.
+ */
+class LoadTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Options
+    {
+        /** Base URL of the server, as shown in the main window. */
+        QUrl serverUrl;
+        std::map<LoadTestClient::Kind, unsigned int> clientCounts;
+        uint16_t universe = 1;
+        unsigned int sendRate = 20;
+        /** Delay between opening each connection. */
+        std::chrono::milliseconds rampInterval{10};
+        /** How long to measure once every client has been started. */
+        std::chrono::seconds duration{30};
+        /** Write per-client results here, if not empty. */
+        QString jsonPath;
+    };
+
+    explicit LoadTest(Options options, QObject *parent = nullptr);
+
+public Q_SLOTS:
+    void start();
+
+Q_SIGNALS:
+    void finished(int exitCode);
+
+private:
+    Options options_;
+    QNetworkAccessManager *nam_;
+    QTimer rampTimer_;
+    std::vector<LoadTestClient *> clients_;
+    std::size_t nextClient_ = 0;
+    std::size_t finishedClients_ = 0;
+    bool reported_ = false;
+
+    void createClients(const QUrl &wsRoot);
+    void stopClients();
+    void report();
+
+private Q_SLOTS:
+    void startNextClient();
+    void onClientFinished();
+};
+
+} // namespace mobilesacn::loadtest
+
+#endif //MOBILESACN_MOBILESACN_LOADTEST_LOADTEST_H
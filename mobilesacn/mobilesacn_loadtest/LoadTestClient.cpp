@@ -0,0 +1,258 @@
+/**
+ * @file LoadTestClient.cpp
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "LoadTestClient.h"
+#include "mobilesacn/libmobilesacn/util.h"
+#include "mobilesacn_messages/ChanCheck.h"
+#include "mobilesacn_messages/ReceiveLevelsReq.h"
+#include "mobilesacn_messages/ReceiveLevelsResp.h"
+#include "mobilesacn_messages/TransmitLevels.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+#include <QMetaEnum>
+
+namespace mobilesacn::loadtest {
+
+LoadTestClient::LoadTestClient(unsigned int id, Options options, QObject *parent) :
+    QObject(parent), id_(id), options_(std::move(options))
+{
+    connect(&ws_, &QWebSocket::connected, this, &LoadTestClient::onConnected);
+    connect(&ws_, &QWebSocket::disconnected, this, &LoadTestClient::onDisconnected);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+    connect(&ws_, &QWebSocket::errorOccurred, this, &LoadTestClient::onError);
+#else
+    connect(
+        &ws_,
+        qOverload<QAbstractSocket::SocketError>(&QWebSocket::error),
+        this,
+        &LoadTestClient::onError);
+#endif
+    connect(&ws_, &QWebSocket::binaryMessageReceived, this, &LoadTestClient::onBinaryMessage);
+
+    sendTimer_.setTimerType(Qt::PreciseTimer);
+    sendTimer_.setInterval(1000 / std::max(options_.sendRate, 1u));
+    connect(&sendTimer_, &QTimer::timeout, this, &LoadTestClient::onSendTimer);
+}
+
+const char *LoadTestClient::kindName(Kind kind)
+{
+    switch (kind) {
+    case Kind::ReceiveLevels:
+        return "ReceiveLevels";
+    case Kind::TransmitLevels:
+        return "TransmitLevels";
+    case Kind::ChanCheck:
+        return "ChanCheck";
+    }
+    return "";
+}
+
+void LoadTestClient::start()
+{
+    stopping_ = false;
+    setupTimer_.start();
+    ws_.open(options_.url);
+}
+
+void LoadTestClient::stop()
+{
+    stopping_ = true;
+    sendTimer_.stop();
+    if (connected_) {
+        stats_.connectedTime += connectedTimer_.elapsed();
+        connected_ = false;
+    }
+    if (ws_.state() == QAbstractSocket::UnconnectedState) {
+        Q_EMIT(finished());
+        return;
+    }
+    ws_.close();
+}
+
+void LoadTestClient::onConnected()
+{
+    stats_.setupTime = setupTimer_.elapsed();
+    connectedTimer_.start();
+    connected_ = true;
+    sendInitialState();
+    if (options_.kind != Kind::ReceiveLevels) {
+        sendTimer_.start();
+    }
+    Q_EMIT(connected());
+}
+
+void LoadTestClient::onDisconnected()
+{
+    sendTimer_.stop();
+    if (connected_) {
+        stats_.connectedTime += connectedTimer_.elapsed();
+        connected_ = false;
+    }
+    if (stopping_) {
+        Q_EMIT(finished());
+        return;
+    }
+    ++stats_.disconnects;
+    SPDLOG_WARN("Client {} ({}) disconnected unexpectedly", id_, kindName(options_.kind));
+}
+
+void LoadTestClient::onError(QAbstractSocket::SocketError error)
+{
+    if (stopping_) {
+        return;
+    }
+    ++stats_.errors;
+    const auto errEnum = QMetaEnum::fromType<QAbstractSocket::SocketError>();
+    SPDLOG_WARN(
+        "Client {} ({}) error: {}", id_, kindName(options_.kind), errEnum.valueToKey(error));
+}
+
+void LoadTestClient::sendMessage(const uint8_t *ptr, qsizetype size)
+{
+    stats_.bytesSent += ws_.sendBinaryMessage({reinterpret_cast<const char *>(ptr), size});
+    ++stats_.messagesSent;
+}
+
+void LoadTestClient::sendInitialState()
+{
+    flatbuffers::FlatBufferBuilder builder;
+    const auto msgUniverse = builder.CreateStruct(message::Universe(options_.universe)).Union();
+    switch (options_.kind) {
+    case Kind::ReceiveLevels:
+        builder.Finish(message::CreateReceiveLevelsReq(
+            builder, message::ReceiveLevelsReqVal::universe, msgUniverse));
+        sendMessage(builder.GetBufferPointer(), builder.GetSize());
+        break;
+    case Kind::TransmitLevels:
+        builder.Finish(message::CreateTransmitLevels(
+            builder, message::TransmitLevelsVal::universe, msgUniverse));
+        sendMessage(builder.GetBufferPointer(), builder.GetSize());
+        builder.Clear();
+        builder.Finish(message::CreateTransmitLevels(
+            builder,
+            message::TransmitLevelsVal::transmit,
+            builder.CreateStruct(message::Transmit(true)).Union()));
+        sendMessage(builder.GetBufferPointer(), builder.GetSize());
+        break;
+    case Kind::ChanCheck:
+        builder.Finish(
+            message::CreateChanCheck(builder, message::ChanCheckVal::universe, msgUniverse));
+        sendMessage(builder.GetBufferPointer(), builder.GetSize());
+        builder.Clear();
+        builder.Finish(message::CreateChanCheck(
+            builder,
+            message::ChanCheckVal::transmit,
+            builder.CreateStruct(message::Transmit(true)).Union()));
+        sendMessage(builder.GetBufferPointer(), builder.GetSize());
+        break;
+    }
+}
+
+void LoadTestClient::onSendTimer()
+{
+    // Simulate a user dragging a fader or stepping through addresses.
+    flatbuffers::FlatBufferBuilder builder;
+    level_ = level_ >= 250 ? 0 : level_ + 5;
+    if (options_.kind == Kind::TransmitLevels) {
+        levels_[address_ - 1] = level_;
+        builder.Finish(message::CreateTransmitLevels(
+            builder,
+            message::TransmitLevelsVal::levels,
+            builder.CreateStruct(message::LevelBuffer(levels_)).Union()));
+        sendMessage(builder.GetBufferPointer(), builder.GetSize());
+    } else if (options_.kind == Kind::ChanCheck) {
+        builder.Finish(message::CreateChanCheck(
+            builder,
+            message::ChanCheckVal::level,
+            builder.CreateStruct(message::Level(level_)).Union()));
+        sendMessage(builder.GetBufferPointer(), builder.GetSize());
+    }
+    if (level_ == 0) {
+        // Full fade complete, move on to the next address.
+        address_ = address_ % levels_.size() + 1;
+        if (options_.kind == Kind::ChanCheck) {
+            builder.Clear();
+            builder.Finish(message::CreateChanCheck(
+                builder,
+                message::ChanCheckVal::address,
+                builder.CreateStruct(message::Address(address_)).Union()));
+            sendMessage(builder.GetBufferPointer(), builder.GetSize());
+        }
+    }
+}
+
+void LoadTestClient::onBinaryMessage(const QByteArray &data)
+{
+    ++stats_.messagesReceived;
+    stats_.bytesReceived += data.size();
+    if (options_.kind == Kind::ReceiveLevels) {
+        handleReceiveLevelsResp(data);
+    }
+}
+
+void LoadTestClient::handleReceiveLevelsResp(const QByteArray &data)
+{
+    flatbuffers::Verifier verifier(reinterpret_cast<const uint8_t *>(data.data()), data.size());
+    if (!message::VerifyReceiveLevelsRespBuffer(verifier)) {
+        ++stats_.malformedMessages;
+        return;
+    }
+
+    handleReceiveLevelsResp(*message::GetReceiveLevelsResp(data.data()));
+}
+
+void LoadTestClient::handleReceiveLevelsResp(const message::ReceiveLevelsResp &msg)
+{
+    const auto now = static_cast<int64_t>(getNowInMilliseconds());
+    const auto timestamp = static_cast<int64_t>(msg.timestamp());
+    if (msg.val_type() == message::ReceiveLevelsRespVal::batch) {
+        for (const auto item : *msg.val_as_batch()->messages()) {
+            if (const auto nested = item->payload_nested_root()) {
+                handleReceiveLevelsResp(*nested);
+            }
+        }
+    } else if (msg.val_type() == message::ReceiveLevelsRespVal::systemTime) {
+        // Calibrate the same way the Web UI does.
+        serverTimeOffset_ = timestamp - now;
+    } else if (
+        msg.val_type() == message::ReceiveLevelsRespVal::levelsChanged
+        || msg.val_type() == message::ReceiveLevelsRespVal::flicker) {
+        const auto latency = now + serverTimeOffset_ - timestamp;
+        stats_.latencies.push_back(latency);
+        if (latency > kStaleFrameMs) {
+            ++stats_.staleFrames;
+        }
+        if (const auto arrivalTimestamp = msg.arrivalTimestamp()) {
+            stats_.serverLatencies.push_back(timestamp - static_cast<int64_t>(*arrivalTimestamp));
+        }
+    }
+}
+
+QJsonObject LoadTestClient::statsJson() const
+{
+    QJsonObject json;
+    json["id"] = static_cast<qint64>(id_);
+    json["kind"] = kindName(options_.kind);
+    json["setupTime"] = stats_.setupTime;
+    json["connectedTime"] = stats_.connectedTime;
+    json["messagesReceived"] = static_cast<qint64>(stats_.messagesReceived);
+    json["bytesReceived"] = static_cast<qint64>(stats_.bytesReceived);
+    json["messagesSent"] = static_cast<qint64>(stats_.messagesSent);
+    json["bytesSent"] = static_cast<qint64>(stats_.bytesSent);
+    json["malformedMessages"] = static_cast<qint64>(stats_.malformedMessages);
+    json["staleFrames"] = static_cast<qint64>(stats_.staleFrames);
+    json["disconnects"] = static_cast<qint64>(stats_.disconnects);
+    json["errors"] = static_cast<qint64>(stats_.errors);
+    if (stats_.connectedTime > 0) {
+        json["messageRate"] = static_cast<double>(stats_.messagesReceived) * 1000.0
+                              / static_cast<double>(stats_.connectedTime);
+    }
+    return json;
+}
+
+} // namespace mobilesacn::loadtest
@@ -0,0 +1,126 @@
+/**
+ * @file LoadTestClient.h
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#ifndef MOBILESACN_MOBILESACN_LOADTEST_LOADTESTCLIENT_H
+#define MOBILESACN_MOBILESACN_LOADTEST_LOADTESTCLIENT_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QTimer>
+#include <QWebSocket>
+
+namespace mobilesacn::message {
+struct ReceiveLevelsResp;
+}
+
+namespace mobilesacn::loadtest {
+
+/**
+ * A simulated phone connected to one of the server's websocket handlers.
+ */
+class LoadTestClient : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Kind {
+        ReceiveLevels,
+        TransmitLevels,
+        ChanCheck,
+    };
+
+    struct Options
+    {
+        Kind kind = Kind::ReceiveLevels;
+        QUrl url;
+        uint16_t universe = 1;
+        /** How often transmitting clients send a change, in Hz. */
+        unsigned int sendRate = 20;
+    };
+
+    explicit LoadTestClient(unsigned int id, Options options, QObject *parent = nullptr);
+
+    static const char *kindName(Kind kind);
+
+    [[nodiscard]] unsigned int id() const { return id_; }
+    [[nodiscard]] Kind kind() const { return options_.kind; }
+    [[nodiscard]] bool isConnected() const { return connected_; }
+
+    /**
+     * Statistics for this client.
+     *
+     * All times are in milliseconds.
+     */
+    struct Stats
+    {
+        /** Time between opening the socket and the server accepting it, or -1 if never connected. */
+        qint64 setupTime = -1;
+        /** Time spent connected. */
+        qint64 connectedTime = 0;
+        uint64_t messagesReceived = 0;
+        uint64_t bytesReceived = 0;
+        uint64_t messagesSent = 0;
+        uint64_t bytesSent = 0;
+        /** Messages that failed FlatBuffer verification. */
+        uint64_t malformedMessages = 0;
+        /** Level frames older than the client would accept (500 ms, same as the Web UI). */
+        uint64_t staleFrames = 0;
+        unsigned int disconnects = 0;
+        unsigned int errors = 0;
+        /** Latency of every level frame, relative to its @c timestamp field. */
+        std::vector<int64_t> latencies;
+        /** Time each level frame spent in the server, from its @c arrival_timestamp field. */
+        std::vector<int64_t> serverLatencies;
+    };
+
+    [[nodiscard]] const Stats &stats() const { return stats_; }
+    [[nodiscard]] QJsonObject statsJson() const;
+
+public Q_SLOTS:
+    void start();
+    void stop();
+
+Q_SIGNALS:
+    void connected();
+    void finished();
+
+private:
+    static constexpr int64_t kStaleFrameMs = 500;
+    unsigned int id_;
+    Options options_;
+    QWebSocket ws_;
+    QElapsedTimer setupTimer_;
+    QElapsedTimer connectedTimer_;
+    QTimer sendTimer_;
+    bool connected_ = false;
+    bool stopping_ = false;
+    int64_t serverTimeOffset_ = 0;
+    uint16_t address_ = 1;
+    uint8_t level_ = 0;
+    std::array<uint8_t, 512> levels_{};
+    Stats stats_;
+
+    void sendMessage(const uint8_t *ptr, qsizetype size);
+    void sendInitialState();
+    void handleReceiveLevelsResp(const QByteArray &data);
+    void handleReceiveLevelsResp(const message::ReceiveLevelsResp &msg);
+
+private Q_SLOTS:
+    void onConnected();
+    void onDisconnected();
+    void onError(QAbstractSocket::SocketError error);
+    void onBinaryMessage(const QByteArray &data);
+    void onSendTimer();
+};
+
+} // namespace mobilesacn::loadtest
+
+#endif //MOBILESACN_MOBILESACN_LOADTEST_LOADTESTCLIENT_H
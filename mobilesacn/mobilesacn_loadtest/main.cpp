@@ -0,0 +1,117 @@
+/**
+ * @file main.cpp
+ *
+ * Simulate many phones connected to a running Mobile sACN server.
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "LoadTest.h"
+#include "mobilesacn_config.h"
+#include <spdlog/spdlog.h>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+
+using namespace mobilesacn;
+using namespace mobilesacn::loadtest;
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setOrganizationName(config::kProjectOrganizationName);
+    app.setOrganizationDomain(config::kProjectOrganizationDomain);
+    app.setApplicationName(QStringLiteral("%1_loadtest").arg(config::kProjectName));
+    app.setApplicationVersion(config::kProjectVersion);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        QStringLiteral("Open many websocket connections to a running %1 server.")
+            .arg(config::kProjectDisplayName));
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument(
+        QStringLiteral("url"), QStringLiteral("Server URL, e.g. http://192.168.1.10:5050"));
+    const QCommandLineOption receiveOption(
+        QStringLiteral("receive"),
+        QStringLiteral("Number of Receive Levels clients."),
+        QStringLiteral("count"),
+        QStringLiteral("0"));
+    parser.addOption(receiveOption);
+    const QCommandLineOption transmitOption(
+        QStringLiteral("transmit"),
+        QStringLiteral("Number of Transmit Levels clients."),
+        QStringLiteral("count"),
+        QStringLiteral("0"));
+    parser.addOption(transmitOption);
+    const QCommandLineOption chanCheckOption(
+        QStringLiteral("chancheck"),
+        QStringLiteral("Number of Channel Check clients."),
+        QStringLiteral("count"),
+        QStringLiteral("0"));
+    parser.addOption(chanCheckOption);
+    const QCommandLineOption universeOption(
+        QStringLiteral("universe"),
+        QStringLiteral("Universe to receive or transmit."),
+        QStringLiteral("universe"),
+        QStringLiteral("1"));
+    parser.addOption(universeOption);
+    const QCommandLineOption sendRateOption(
+        QStringLiteral("send-rate"),
+        QStringLiteral("Changes per second sent by each transmitting client."),
+        QStringLiteral("hz"),
+        QStringLiteral("20"));
+    parser.addOption(sendRateOption);
+    const QCommandLineOption rampOption(
+        QStringLiteral("ramp"),
+        QStringLiteral("Milliseconds between opening each connection."),
+        QStringLiteral("ms"),
+        QStringLiteral("10"));
+    parser.addOption(rampOption);
+    const QCommandLineOption durationOption(
+        QStringLiteral("duration"),
+        QStringLiteral("Seconds to measure once all clients are started."),
+        QStringLiteral("seconds"),
+        QStringLiteral("30"));
+    parser.addOption(durationOption);
+    const QCommandLineOption jsonOption(
+        QStringLiteral("json"),
+        QStringLiteral("Write per-client results to this file."),
+        QStringLiteral("path"));
+    parser.addOption(jsonOption);
+    parser.process(app);
+
+    if (parser.positionalArguments().size() != 1) {
+        parser.showHelp(1);
+    }
+    const QUrl serverUrl(parser.positionalArguments().front());
+    if (!serverUrl.isValid()) {
+        SPDLOG_CRITICAL("Invalid server URL");
+        return 1;
+    }
+
+    const auto universe = parser.value(universeOption).toUShort();
+    if (universe == 0 || universe > 63999) {
+        SPDLOG_CRITICAL("Universe must be between 1 and 63999");
+        return 1;
+    }
+
+    LoadTest loadTest(LoadTest::Options{
+        .serverUrl = serverUrl,
+        .clientCounts = {
+            {LoadTestClient::Kind::ReceiveLevels, parser.value(receiveOption).toUInt()},
+            {LoadTestClient::Kind::TransmitLevels, parser.value(transmitOption).toUInt()},
+            {LoadTestClient::Kind::ChanCheck, parser.value(chanCheckOption).toUInt()},
+        },
+        .universe = universe,
+        .sendRate = parser.value(sendRateOption).toUInt(),
+        .rampInterval = std::chrono::milliseconds(parser.value(rampOption).toUInt()),
+        .duration = std::chrono::seconds(parser.value(durationOption).toUInt()),
+        .jsonPath = parser.value(jsonOption),
+    });
+    QObject::connect(&loadTest, &LoadTest::finished, &app, &QCoreApplication::exit);
+    QMetaObject::invokeMethod(&loadTest, &LoadTest::start, Qt::QueuedConnection);
+
+    return QCoreApplication::exec();
+}
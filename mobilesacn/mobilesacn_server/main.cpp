@@ -0,0 +1,268 @@
+/**
+ * @file main.cpp
+ *
+ * Run the server without a GUI.
+ *
+ * @author Dan Keenan
+ * @date 10/19/26
+ * @copyright Apache-2.0
+ */
+
+#include "mobilesacn/libmobilesacn/Application.h"
+#include "mobilesacn/libmobilesacn/HttpServer.h"
+#include "mobilesacn/libmobilesacn/Settings.h"
+#include "mobilesacn/libmobilesacn/Trace.h"
+#include "mobilesacn/libmobilesacn/logging.h"
+#include "mobilesacn_config.h"
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <etcpal/cpp/common.h>
+#include <etcpal/cpp/netint.h>
+#include <fmt/format.h>
+#include <optional>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#ifdef Q_OS_UNIX
+#include <sys/socket.h>
+#include <unistd.h>
+#include <QSocketNotifier>
+#endif
+
+using namespace mobilesacn;
+
+static constexpr auto kEtcPalFeatures = ETCPAL_FEATURE_LOGGING | ETCPAL_FEATURE_NETINTS;
+
+#ifdef Q_OS_UNIX
+/** Written to from the signal handler so the event loop can quit safely. */
+static int signalFds[2];
+
+static void onSignal(int)
+{
+    const char c = 1;
+    [[maybe_unused]] const auto written = ::write(signalFds[1], &c, sizeof(c));
+}
+#endif
+
+/**
+ * Quit the event loop on SIGINT or SIGTERM, so the server shuts down cleanly.
+ */
+static void setupSignalHandlers(QCoreApplication &app)
+{
+#ifdef Q_OS_UNIX
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, signalFds) != 0) {
+        SPDLOG_WARN("Could not create signal socket: {}", std::strerror(errno));
+        return;
+    }
+    auto notifier = new QSocketNotifier(signalFds[0], QSocketNotifier::Read, &app);
+    QObject::connect(notifier, &QSocketNotifier::activated, &app, []() {
+        char c;
+        [[maybe_unused]] const auto read = ::read(signalFds[0], &c, sizeof(c));
+        SPDLOG_INFO("Shutting down");
+        QCoreApplication::quit();
+    });
+
+    struct sigaction action = {};
+    action.sa_handler = onSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+#else
+    // Console control handlers run on their own thread, and quit() is thread-safe.
+    std::signal(SIGINT, [](int) { QCoreApplication::quit(); });
+    std::signal(SIGTERM, [](int) { QCoreApplication::quit(); });
+#endif
+}
+
+/**
+ * Find the interface that is up and has @p nameOrAddress as its name or address.
+ */
+static std::optional<etcpal::NetintInfo> findInterface(const QString &nameOrAddress)
+{
+    const auto netints = etcpal::netint::GetInterfaces();
+    if (!netints) {
+        SPDLOG_CRITICAL("Could not load network interfaces.");
+        return {};
+    }
+    const auto needle = nameOrAddress.toStdString();
+    for (const auto &netint : *netints) {
+        if (!etcpal::netint::IsUp(netint)) {
+            continue;
+        }
+        if (netint.friendly_name() == needle || netint.addr().ToString() == needle) {
+            return netint;
+        }
+    }
+    return {};
+}
+
+static void listInterfaces()
+{
+    const auto netints = etcpal::netint::GetInterfaces();
+    if (!netints) {
+        SPDLOG_CRITICAL("Could not load network interfaces.");
+        return;
+    }
+    for (const auto &netint : *netints) {
+        if (!etcpal::netint::IsUp(netint)) {
+            continue;
+        }
+        fmt::println(
+            "{}\t{}\t{}{}",
+            netint.friendly_name(),
+            netint.addr().ToString(),
+            netint.mac().ToString(),
+            netint.is_default() ? "\t(default)" : "");
+    }
+}
+
+/**
+ * Start the server and run until asked to quit.
+ *
+ * @return Exit code.
+ */
+static int runServer(const QCommandLineParser &parser)
+{
+    if (parser.isSet(QStringLiteral("list-ifaces"))) {
+        listInterfaces();
+        return 0;
+    }
+
+    const auto webIfaceName = parser.isSet(QStringLiteral("web-iface"))
+                                  ? parser.value(QStringLiteral("web-iface"))
+                                  : Settings::getLastWebUiInterfaceName();
+    const auto sacnIfaceName = parser.isSet(QStringLiteral("sacn-iface"))
+                                   ? parser.value(QStringLiteral("sacn-iface"))
+                                   : Settings::getLastSacnInterfaceName();
+    if (webIfaceName.isEmpty() || sacnIfaceName.isEmpty()) {
+        SPDLOG_CRITICAL("No interface given. Use --web-iface and --sacn-iface.");
+        return 1;
+    }
+    const auto webIface = findInterface(webIfaceName);
+    if (!webIface) {
+        SPDLOG_CRITICAL("Interface {} not found or not up.", webIfaceName.toStdString());
+        return 1;
+    }
+    const auto sacnIface = findInterface(sacnIfaceName);
+    if (!sacnIface) {
+        SPDLOG_CRITICAL("Interface {} not found or not up.", sacnIfaceName.toStdString());
+        return 1;
+    }
+
+    bool portOk = false;
+    const auto port = parser.value(QStringLiteral("port")).toUShort(&portOk);
+    if (!portOk || port == 0) {
+        SPDLOG_CRITICAL("Invalid port {}", parser.value(QStringLiteral("port")).toStdString());
+        return 1;
+    }
+
+    const auto linger
+        = std::chrono::seconds(parser.value(QStringLiteral("receiver-linger")).toUInt());
+    Application application;
+    const auto started = application.start(Application::Options{
+        .backend_address = webIface->addr().ToString(),
+        .sacn_address = sacnIface->addr().ToString(),
+        .http_port = port,
+        .worker_threads = parser.value(QStringLiteral("threads")).toUInt(),
+        .receiver_pool = {
+            .linger = linger,
+            .max_receivers = parser.value(QStringLiteral("max-receivers")).toUInt(),
+            .prewarm = parser.isSet(QStringLiteral("prewarm")),
+        },
+    });
+    if (!started) {
+        return 1;
+    }
+
+    const auto ret = QCoreApplication::exec();
+    application.stop();
+    return ret;
+}
+
+int main(int argc, char *argv[])
+{
+    const auto startTime = std::chrono::steady_clock::now();
+
+    QCoreApplication app(argc, argv);
+    // Same names as the GUI, so both share settings.
+    app.setOrganizationName(config::kProjectOrganizationName);
+    app.setOrganizationDomain(config::kProjectOrganizationDomain);
+    app.setApplicationName(config::kProjectName);
+    app.setApplicationVersion(config::kProjectVersion);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        QStringLiteral("Run the %1 server without a GUI.").arg(config::kProjectDisplayName));
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addOptions({
+        {QStringLiteral("web-iface"),
+         QStringLiteral(
+             "Interface name or address serving the Web UI. Defaults to the last interface used."),
+         QStringLiteral("iface")},
+        {QStringLiteral("sacn-iface"),
+         QStringLiteral("Interface name or address for sACN. Defaults to the last interface used."),
+         QStringLiteral("iface")},
+        {QStringLiteral("port"),
+         QStringLiteral("Port serving the Web UI."),
+         QStringLiteral("port"),
+         QString::number(HttpServer::kDefaultPort)},
+        {QStringLiteral("threads"),
+         QStringLiteral("Number of threads running web handlers, or 0 to use one per core."),
+         QStringLiteral("count"),
+         QStringLiteral("0")},
+        {QStringLiteral("receiver-linger"),
+         QStringLiteral("Seconds to keep receiving a universe after the last client leaves it."),
+         QStringLiteral("seconds"),
+         QString::number(std::chrono::duration_cast<std::chrono::seconds>(
+                             handler::MergeReceiverPool::Options{}.linger)
+                             .count())},
+        {QStringLiteral("max-receivers"),
+         QStringLiteral("Most universes to receive at once. Universes being viewed count toward "
+                        "this, but are never stopped to stay under it."),
+         QStringLiteral("count"),
+         QString::number(handler::MergeReceiverPool::Options{}.max_receivers)},
+        {QStringLiteral("prewarm"),
+         QStringLiteral("Start receiving universes as soon as they are found on the network.")},
+        {QStringLiteral("list-ifaces"), QStringLiteral("List available interfaces and exit.")},
+        {QStringLiteral("verbose"), QStringLiteral("Log debug messages.")},
+        {QStringLiteral("trace"),
+         QStringLiteral("Record hot path timings from startup. Download them from /trace.")},
+    });
+    parser.process(app);
+
+    setupAsyncLogging(
+        {std::make_shared<spdlog::sinks::stdout_color_sink_mt>()},
+        parser.isSet(QStringLiteral("verbose")) ? spdlog::level::debug : spdlog::level::info);
+    setupSignalHandlers(app);
+    if (parser.isSet(QStringLiteral("trace"))) {
+        Tracer::get().setEnabled(true);
+    }
+
+    // Init EtcPal.
+    etcpal_init(kEtcPalFeatures);
+
+    // Report startup time once the event loop is running, i.e. the server is ready.
+    QMetaObject::invokeMethod(
+        &app,
+        [startTime]() {
+            SPDLOG_INFO(
+                "Started in {} ms",
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - startTime)
+                    .count());
+        },
+        Qt::QueuedConnection);
+    const auto ret = runServer(parser);
+
+    // Deinit etcpal.
+    etcpal_deinit(kEtcPalFeatures);
+
+    // Flush queued log messages.
+    spdlog::shutdown();
+
+    return ret;
+}